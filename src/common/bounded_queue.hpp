@@ -0,0 +1,111 @@
+/**
+ * @file    bounded_queue.hpp
+ *
+ * @brief   A thread-safe queue with a fixed capacity.
+ *
+ * @section DESCRIPTION
+ *
+ * Hands items from producer threads to consumer threads. Producers wait while the queue is full,
+ * so a fast producer can't run ahead of slow consumers and pile up items in memory.
+ */
+
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <mutex>
+#include <utility>
+
+namespace raychess
+{
+    /**
+     * @brief   A thread-safe first in, first out queue with a fixed capacity.
+     *
+     * Once closed, no more items are accepted, and consumers get the items left in the queue
+     * before being told it is done.
+     *
+     * @tparam  T  The item type, which must be movable.
+     */
+    template <typename T>
+    class BoundedQueue
+    {
+    public:
+        /**
+         * @brief       Constructor.
+         *
+         * @param[in]   capacity  The most items the queue holds, at least 1.
+         */
+        explicit BoundedQueue(std::size_t capacity) noexcept
+            : capacity_(capacity > 0 ? capacity : 1), closed_(false)
+        {
+        }
+
+        BoundedQueue(const BoundedQueue&) = delete;
+        BoundedQueue& operator=(const BoundedQueue&) = delete;
+
+        /**
+         * @brief       Appends an item, waiting while the queue is full.
+         *
+         * @param[in]   item  The item to append.
+         *
+         * @return      True if the item was appended, false if the queue is closed.
+         */
+        bool Push(T item) noexcept
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            not_full_.wait(lock, [this] { return closed_ || items_.size() < capacity_; });
+            if (closed_) {
+                return false;
+            }
+
+            items_.push_back(std::move(item));
+            lock.unlock();
+            not_empty_.notify_one();
+            return true;
+        }
+
+        /**
+         * @brief       Removes the first item, waiting while the queue is empty.
+         *
+         * @param[out]  item  The item removed.
+         *
+         * @return      True if an item was removed, false if the queue is closed and empty.
+         */
+        bool Pop(T& item) noexcept
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            not_empty_.wait(lock, [this] { return closed_ || !items_.empty(); });
+            if (items_.empty()) {
+                return false;
+            }
+
+            item = std::move(items_.front());
+            items_.pop_front();
+            lock.unlock();
+            not_full_.notify_one();
+            return true;
+        }
+
+        /**
+         * @brief       Closes the queue, waking up all waiting threads.
+         */
+        void Close(void) noexcept
+        {
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                closed_ = true;
+            }
+            not_full_.notify_all();
+            not_empty_.notify_all();
+        }
+
+    private:
+        std::mutex mutex_;                   ///< Guards all other members.
+        std::condition_variable not_full_;   ///< Signalled when an item is removed.
+        std::condition_variable not_empty_;  ///< Signalled when an item is appended.
+        std::deque<T> items_;                ///< The items, first to be removed at the front.
+        std::size_t capacity_;               ///< The most items the queue holds.
+        bool closed_;                        ///< Whether the queue accepts no more items.
+    };
+}  // namespace raychess
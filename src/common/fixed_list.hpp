@@ -0,0 +1,117 @@
+/**
+ * @file    fixed_list.hpp
+ *
+ * @brief   A list with a fixed capacity and no heap allocations.
+ *
+ * @section DESCRIPTION
+ *
+ * A sequence container similar to std::vector, but with its capacity fixed at compile time and its
+ * storage embedded in the object itself. Meant for short-lived lists living on the stack.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <new>
+#include <type_traits>
+
+namespace raychess
+{
+    /**
+     * @brief   A list with a fixed capacity and no heap allocations.
+     *
+     * The storage is left uninitialised until elements are appended, so creating a list costs
+     * nothing regardless of its capacity. Only trivially destructible types are supported, which
+     * is also why clearing the list is free.
+     *
+     * The lowercase begin() and end() methods are there so the list works with range-based for
+     * loops and standard algorithms.
+     *
+     * @tparam  T         The element type.
+     * @tparam  Capacity  The maximum number of elements.
+     */
+    template <typename T, std::size_t Capacity>
+    class FixedList
+    {
+        static_assert(std::is_trivially_destructible<T>::value,
+                      "FixedList only supports trivially destructible types");
+
+    public:
+        /**
+         * @brief       Default constructor. Creates an empty list.
+         */
+        FixedList() noexcept : size_(0) {}
+
+        /**
+         * @brief       Appends an element to the end of the list.
+         *
+         * The list must not be full.
+         *
+         * @param[in]   value  The element to append.
+         */
+        void PushBack(const T& value) noexcept { new (&Data()[size_++]) T(value); }
+
+        /**
+         * @brief       Removes the last element of the list.
+         *
+         * The list must not be empty.
+         */
+        void PopBack(void) noexcept { size_--; }
+
+        /**
+         * @brief       Removes all elements from the list.
+         */
+        void Clear(void) noexcept { size_ = 0; }
+
+        /**
+         * @brief       Size getter.
+         *
+         * @return      The number of elements in the list.
+         */
+        std::size_t Size(void) const noexcept { return size_; }
+
+        /**
+         * @brief       Checks whether the list is empty.
+         *
+         * @return      True if there are no elements in the list, false otherwise.
+         */
+        bool IsEmpty(void) const noexcept { return size_ == 0; }
+
+        /**
+         * @brief       Capacity getter.
+         *
+         * @return      The maximum number of elements the list can hold.
+         */
+        static constexpr std::size_t GetCapacity(void) noexcept { return Capacity; }
+
+        /**
+         * @brief       Element access. The index must be smaller than the size of the list.
+         *
+         * @param[in]   index  The index of the element.
+         *
+         * @return      A reference to the element.
+         */
+        T& operator[](std::size_t index) noexcept { return Data()[index]; }
+
+        /**
+         * @brief       Element access. The index must be smaller than the size of the list.
+         *
+         * @param[in]   index  The index of the element.
+         *
+         * @return      A const reference to the element.
+         */
+        const T& operator[](std::size_t index) const noexcept { return Data()[index]; }
+
+        T* begin(void) noexcept { return Data(); }                    ///< The first element.
+        T* end(void) noexcept { return Data() + size_; }              ///< Past the last element.
+        const T* begin(void) const noexcept { return Data(); }        ///< The first element.
+        const T* end(void) const noexcept { return Data() + size_; }  ///< Past the last element.
+
+    private:
+        T* Data(void) noexcept { return reinterpret_cast<T*>(&storage_); }
+        const T* Data(void) const noexcept { return reinterpret_cast<const T*>(&storage_); }
+
+        typename std::aligned_storage<sizeof(T) * Capacity, alignof(T)>::type storage_;  ///< Items.
+        std::size_t size_;  ///< The number of elements in the list.
+    };
+}  // namespace raychess
@@ -6,13 +6,15 @@
  * @section DESCRIPTION
  *
  * A temporary class to represent a discrete 2D position with some accompanying methods.
+ *
+ * Everything is constexpr and defined in the header, so position arithmetic in the inner loops of
+ * move generation can be folded by the compiler instead of being a call into another translation
+ * unit.
  */
 
 #pragma once
 
-#define _USE_MATH_DEFINES
-#include <cmath>
-#include <cstdlib>
+#include <type_traits>
 
 namespace raychess
 {
@@ -39,20 +41,23 @@ namespace raychess
             DOWN_RIGHT
         };
 
+        static constexpr int kDirectionCount = 8;  ///< Number of Direction2D values.
+        static constexpr int kBoardSize = 8;  ///< Number of files (and ranks) of a square index.
+
         int x;  ///< The X component.
         int y;  ///< The Y component.
 
         /**
          * @brief       Default constructor. Initializes to (0, 0).
          */
-        Position2D() noexcept;
+        constexpr Position2D() noexcept : x(0), y(0) {}
 
         /**
          * @brief       Constructor. Initializes to (xy, xy).
          *
          * @param[in]   xy  The value to initialize both components to.
          */
-        Position2D(int xy) noexcept;
+        constexpr Position2D(int xy) noexcept : x(xy), y(xy) {}
 
         /**
          * @brief       Constructor. Initializes to (x, y).
@@ -60,14 +65,38 @@ namespace raychess
          * @param[in]   x  The X component.
          * @param[in]   y  The Y component.
          */
-        Position2D(int x, int y) noexcept;
+        constexpr Position2D(int x, int y) noexcept : x(x), y(y) {}
 
         /**
          * @brief       Direction-based constructor. Initializes to (0, 0) + direction.
          *
          * @param[in]   direction  The Position2D::Direction2D to initialize to.
          */
-        Position2D(Direction2D direction) noexcept;
+        constexpr Position2D(Direction2D direction) noexcept
+            : x(DirectionX(direction)), y(DirectionY(direction))
+        {
+        }
+
+        /**
+         * @brief       Converts a square index of an 8x8 board to a position.
+         *
+         * @param[in]   square  The square index to convert, A1 being 0, B1 1 and H8 63.
+         *
+         * @return      The position of the square.
+         */
+        static constexpr Position2D FromSquareIndex(int square) noexcept
+        {
+            return Position2D(square % kBoardSize, square / kBoardSize);
+        }
+
+        /**
+         * @brief       Converts the position to a square index of an 8x8 board.
+         *
+         * The position must lie on the 8x8 board.
+         *
+         * @return      The square index of the position, A1 being 0, B1 1 and H8 63.
+         */
+        constexpr int ToSquareIndex(void) const noexcept { return y * kBoardSize + x; }
 
         /**
          * @brief       Adds another Position2D to this one and returns the result.
@@ -76,14 +105,21 @@ namespace raychess
          *
          * @return      A new Position2D with the result of the addition.
          */
-        inline Position2D operator+(const Position2D &rhs) const noexcept;
+        constexpr Position2D operator+(const Position2D &rhs) const noexcept
+        {
+            return Position2D(x + rhs.x, y + rhs.y);
+        }
 
         /**
          * @brief       Adds another Position2D to this one.
          *
          * @param[in]   rhs  The Position2D to add.
          */
-        inline void operator+=(const Position2D &rhs) noexcept;
+        constexpr void operator+=(const Position2D &rhs) noexcept
+        {
+            x += rhs.x;
+            y += rhs.y;
+        }
 
         /**
          * @brief       Subtracts another Position2D from this one and returns the result.
@@ -92,14 +128,21 @@ namespace raychess
          *
          * @return      A new Position2D with the result of the subtraction.
          */
-        inline Position2D operator-(const Position2D &rhs) const noexcept;
+        constexpr Position2D operator-(const Position2D &rhs) const noexcept
+        {
+            return Position2D(x - rhs.x, y - rhs.y);
+        }
 
         /**
          * @brief       Subtracts another Position2D from this one.
          *
          * @param[in]   rhs  The Position2D to subtract.
          */
-        inline void operator-=(const Position2D &rhs) noexcept;
+        constexpr void operator-=(const Position2D &rhs) noexcept
+        {
+            x -= rhs.x;
+            y -= rhs.y;
+        }
 
         /**
          * @brief       Multiplies this Position2D by a scalar and returns the result.
@@ -108,14 +151,21 @@ namespace raychess
          *
          * @return      A new Position2D with the result of the multiplication.
          */
-        inline Position2D operator*(const int &rhs) const noexcept;
+        constexpr Position2D operator*(const int &rhs) const noexcept
+        {
+            return Position2D(x * rhs, y * rhs);
+        }
 
         /**
          * @brief       Multiplies this Position2D by a scalar.
          *
          * @param[in]   scalar  The scalar to multiply by.
          */
-        inline void operator*=(const int &rhs) noexcept;
+        constexpr void operator*=(const int &rhs) noexcept
+        {
+            x *= rhs;
+            y *= rhs;
+        }
 
         /**
          * @brief       Compares this Position2D to another.
@@ -124,7 +174,10 @@ namespace raychess
          *
          * @return      True if the two Position2Ds are equal, false otherwise.
          */
-        inline bool operator==(const Position2D &rhs) const noexcept;
+        constexpr bool operator==(const Position2D &rhs) const noexcept
+        {
+            return (x == rhs.x && y == rhs.y);
+        }
 
         /**
          * @brief       Compares this Position2D to another.
@@ -133,6 +186,52 @@ namespace raychess
          *
          * @return      True if the two Position2Ds are not equal, false otherwise.
          */
-        inline bool operator!=(const Position2D &rhs) const noexcept;
+        constexpr bool operator!=(const Position2D &rhs) const noexcept
+        {
+            return (x != rhs.x || y != rhs.y);
+        }
+
+    private:
+        /**
+         * @brief       Gets the X component of a direction.
+         *
+         * @param[in]   direction  The direction.
+         *
+         * @return      The X component, -1, 0 or 1.
+         */
+        static constexpr int DirectionX(Direction2D direction) noexcept
+        {
+            constexpr int kX[kDirectionCount] = {0, 0, -1, 1, -1, 1, -1, 1};
+            return kX[static_cast<int>(direction)];
+        }
+
+        /**
+         * @brief       Gets the Y component of a direction.
+         *
+         * @param[in]   direction  The direction.
+         *
+         * @return      The Y component, -1, 0 or 1.
+         */
+        static constexpr int DirectionY(Direction2D direction) noexcept
+        {
+            constexpr int kY[kDirectionCount] = {1, -1, 0, 0, 1, 1, -1, -1};
+            return kY[static_cast<int>(direction)];
+        }
     };
+
+    static_assert(std::is_trivially_copyable<Position2D>::value,
+                  "Position2D is passed around by value in the inner loops");
+
+    /**
+     * @brief   The offsets of all directions, in the order of Position2D::Direction2D.
+     */
+    constexpr Position2D kDirectionOffsets[Position2D::kDirectionCount] = {
+        Position2D(0, 1),  Position2D(0, -1), Position2D(-1, 0), Position2D(1, 0),
+        Position2D(-1, 1), Position2D(1, 1),  Position2D(-1, -1), Position2D(1, -1)};
+
+    static_assert(kDirectionOffsets[static_cast<int>(Position2D::Direction2D::DOWN_RIGHT)] ==
+                      Position2D(Position2D::Direction2D::DOWN_RIGHT),
+                  "The direction offsets follow the order of Position2D::Direction2D");
+    static_assert(Position2D::FromSquareIndex(Position2D(7, 7).ToSquareIndex()) == Position2D(7, 7),
+                  "Square indices and positions convert back and forth");
 }  // namespace raychess
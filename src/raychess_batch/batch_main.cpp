@@ -0,0 +1,144 @@
+/**
+ * @file    batch_main.cpp
+ *
+ * @brief   Entry point of the batch analysis executable.
+ *
+ * @section DESCRIPTION
+ *
+ * Analyses every position of a PGN or EPD file and writes the results in input order.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+
+#include "batch_pipeline.hpp"
+#include "mapped_file.hpp"
+
+using namespace raychess;
+
+namespace
+{
+    /**
+     * @brief       Prints the usage of the executable.
+     *
+     * @param[in]   program  Name of the executable.
+     */
+    void PrintUsage(const char* program) noexcept
+    {
+        std::printf("Usage: %s [options] <input> [output]\n\n", program);
+        std::printf("Options:\n");
+        std::printf("  --threads <count>       Worker threads (default: all cores)\n");
+        std::printf("  --analysis <kind>       moves, material or search (default moves)\n");
+        std::printf("  --depth <depth>         Depth of the searches (default 6)\n");
+        std::printf("  --hash <MB>             Transposition table of every worker (default 16)\n");
+        std::printf("  --chunk <KB>            Size of the chunks of the input (default 256)\n\n");
+        std::printf("Files ending in .pgn are read as games, anything else as one FEN or EPD\n");
+        std::printf("position per line. Every position is written as a line of its FEN followed\n");
+        std::printf("by the result, in input order, to the output file or the standard output.\n");
+    }
+
+    /**
+     * @brief       Checks whether a path ends in the PGN extension.
+     *
+     * @param[in]   path  The path.
+     *
+     * @return      True if the path ends in ".pgn", in any case, false otherwise.
+     */
+    bool IsPgnPath(const char* path) noexcept
+    {
+        const std::size_t length = std::strlen(path);
+        if (length < 4) {
+            return false;
+        }
+
+        const char* extension = path + length - 4;
+        return extension[0] == '.' && std::strchr("pP", extension[1]) != nullptr &&
+               std::strchr("gG", extension[2]) != nullptr &&
+               std::strchr("nN", extension[3]) != nullptr;
+    }
+}  // namespace
+
+int main(int argc, char* argv[])
+{
+    batch::Options options;
+    options.thread_count = std::max(1u, std::thread::hardware_concurrency());
+    int first = 1;
+
+    for (; first + 1 < argc && std::strncmp(argv[first], "--", 2) == 0; first += 2) {
+        const char* value = argv[first + 1];
+
+        if (std::strcmp(argv[first], "--threads") == 0) {
+            options.thread_count = static_cast<unsigned int>(std::max(1, std::atoi(value)));
+        }
+        else if (std::strcmp(argv[first], "--analysis") == 0 &&
+                 std::strcmp(value, "moves") == 0) {
+            options.analysis = batch::Analysis::MOVES;
+        }
+        else if (std::strcmp(argv[first], "--analysis") == 0 &&
+                 std::strcmp(value, "material") == 0) {
+            options.analysis = batch::Analysis::MATERIAL;
+        }
+        else if (std::strcmp(argv[first], "--analysis") == 0 &&
+                 std::strcmp(value, "search") == 0) {
+            options.analysis = batch::Analysis::SEARCH;
+        }
+        else if (std::strcmp(argv[first], "--depth") == 0) {
+            options.depth = std::max(1, std::atoi(value));
+        }
+        else if (std::strcmp(argv[first], "--hash") == 0) {
+            options.hash_mb = static_cast<std::size_t>(std::max(1, std::atoi(value)));
+        }
+        else if (std::strcmp(argv[first], "--chunk") == 0) {
+            options.chunk_kb = static_cast<std::size_t>(std::max(1, std::atoi(value)));
+        }
+        else {
+            PrintUsage(argv[0]);
+            return EXIT_FAILURE;
+        }
+    }
+
+    if (first >= argc || first + 2 < argc) {
+        PrintUsage(argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    const char* input_path = argv[first];
+    MappedFile input;
+    if (!input.Open(input_path)) {
+        std::fprintf(stderr, "Cannot open %s\n", input_path);
+        return EXIT_FAILURE;
+    }
+    options.format = IsPgnPath(input_path) ? batch::Format::PGN : batch::Format::EPD;
+
+    std::FILE* output = stdout;
+    if (first + 1 < argc) {
+        output = std::fopen(argv[first + 1], "wb");
+        if (output == nullptr) {
+            std::fprintf(stderr, "Cannot open %s\n", argv[first + 1]);
+            return EXIT_FAILURE;
+        }
+    }
+
+    const auto start = std::chrono::steady_clock::now();
+    const batch::Summary summary =
+        batch::Run(input.GetData(), input.GetSize(), output, options);
+    const double seconds =
+        std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    const bool written = std::fflush(output) == 0;
+    if (output != stdout) {
+        std::fclose(output);
+    }
+
+    // The summary goes to the standard error, so it doesn't mix with results written to stdout.
+    std::fprintf(stderr, "%llu positions (%llu skipped) in %.3f s with %u thread(s), %.0f/s\n",
+                 static_cast<unsigned long long>(summary.positions),
+                 static_cast<unsigned long long>(summary.skipped), seconds, options.thread_count,
+                 summary.positions / seconds);
+
+    return written ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,317 @@
+/**
+ * @file    batch_pipeline.cpp
+ *
+ * @brief   Parallel analysis of position collections.
+ *
+ * @section DESCRIPTION
+ *
+ * One thread splits the input into chunks and hands them to the workers, which each own a board
+ * (and for searches a searcher and a transposition table). Every chunk comes with a future of its
+ * results, and the futures are queued in input order for the writer, the calling thread. Both
+ * queues are bounded, which keeps the number of chunks in flight fixed.
+ */
+
+#include "batch_pipeline.hpp"
+
+#include <atomic>
+#include <cstring>
+#include <future>
+#include <memory>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "board_area.hpp"
+#include "bounded_queue.hpp"
+#include "fen.hpp"
+#include "move_generator.hpp"
+#include "move_list.hpp"
+#include "pgn.hpp"
+#include "searcher.hpp"
+#include "transposition_table.hpp"
+
+using namespace raychess;
+using namespace raychess::batch;
+
+namespace
+{
+    constexpr std::size_t kChunksPerThread = 2;  ///< Chunks in flight per worker thread.
+
+    /**
+     * @brief   The results of analysing a chunk.
+     */
+    struct ChunkResult
+    {
+        std::string text;             ///< The output lines of the chunk.
+        std::uint64_t positions = 0;  ///< Number of positions analysed.
+        std::uint64_t skipped = 0;    ///< Number of lines or games which couldn't be read.
+    };
+
+    /**
+     * @brief   A chunk of the input waiting for a worker.
+     */
+    struct Job
+    {
+        const char* begin;                 ///< The first character of the chunk.
+        const char* end;                   ///< One past the last character of the chunk.
+        std::promise<ChunkResult> result;  ///< Receives the results of the chunk.
+    };
+
+    /**
+     * @brief       Checks whether a line holds nothing but whitespace.
+     *
+     * @param[in]   begin  The first character of the line.
+     * @param[in]   end    One past the last character of the line.
+     *
+     * @return      True if the line is blank, false otherwise.
+     */
+    bool IsBlank(const char* begin, const char* end) noexcept
+    {
+        for (; begin != end; begin++) {
+            if (*begin != ' ' && *begin != '\t' && *begin != '\r') {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /**
+     * @brief   Analyses chunks of the input on a board of its own.
+     */
+    class Worker
+    {
+    public:
+        /**
+         * @brief       Constructor.
+         *
+         * @param[in]   options  The options of the analysis.
+         */
+        explicit Worker(const Options& options) noexcept : options_(options), board_(8, 8)
+        {
+            if (options.analysis == Analysis::SEARCH) {
+                table_.reset(new TranspositionTable(options.hash_mb));
+                searcher_.reset(new search::Searcher(*table_));
+                limits_.depth = options.depth;
+            }
+        }
+
+        /**
+         * @brief       Analyses a chunk of the input.
+         *
+         * The search state is cleared first, so that the results of a chunk don't depend on
+         * which worker got it, or on what that worker analysed before.
+         *
+         * @param[in]   begin  The first character of the chunk.
+         * @param[in]   end    One past the last character of the chunk.
+         *
+         * @return      The results of the chunk.
+         */
+        ChunkResult Analyse(const char* begin, const char* end) noexcept
+        {
+            ChunkResult result;
+
+            if (searcher_) {
+                table_->Clear();
+                searcher_->ClearHeuristics();
+            }
+
+            if (options_.format == Format::PGN) {
+                pgn::Reader reader(begin, static_cast<std::size_t>(end - begin));
+                pgn::Game game;
+
+                // The reader only passes positions of games it read completely, so games
+                // counted as skipped leave no lines behind.
+                const auto callback = [this, &result](const BoardArea& board, Move) {
+                    AnalysePosition(board, result);
+                };
+
+                while (reader.ReadGame(game, callback)) {
+                }
+                result.skipped = reader.GetSkippedGames();
+                return result;
+            }
+
+            for (const char* line = begin; line != end;) {
+                const char* line_end =
+                    static_cast<const char*>(std::memchr(line, '\n', end - line));
+                line_end = (line_end != nullptr ? line_end : end);
+
+                const auto line_length = static_cast<std::size_t>(line_end - line);
+                if (!IsBlank(line, line_end)) {
+                    if (fen::LoadPosition(board_, line, line_length)) {
+                        AnalysePosition(board_, result);
+                    }
+                    else {
+                        result.skipped++;
+                    }
+                }
+
+                line = (line_end != end ? line_end + 1 : end);
+            }
+
+            return result;
+        }
+
+    private:
+        /**
+         * @brief       Analyses a position and appends its output line.
+         *
+         * @param[in]       board   The board holding the position.
+         * @param[in,out]   result  The results of the chunk.
+         */
+        void AnalysePosition(const BoardArea& board, ChunkResult& result) noexcept
+        {
+            char line[fen::kMaxLength + 32];
+            std::size_t length = fen::SavePosition(board, line);
+
+            switch (options_.analysis) {
+                case Analysis::MOVES: {
+                    const MoveGenerator generator(board);
+                    MoveList moves;
+                    generator.GenerateMoves(moves);
+                    length += std::snprintf(line + length, sizeof(line) - length, " %zu\n",
+                                            moves.Size());
+                    break;
+                }
+
+                case Analysis::MATERIAL: {
+                    int balance = 0;
+                    for (const auto& piece : board.GetPiecesByColour(PieceColour::WHITE)) {
+                        balance += piece->GetPointEvaulation();
+                    }
+                    for (const auto& piece : board.GetPiecesByColour(PieceColour::BLACK)) {
+                        balance -= piece->GetPointEvaulation();
+                    }
+                    length += std::snprintf(line + length, sizeof(line) - length, " %d\n",
+                                            balance);
+                    break;
+                }
+
+                case Analysis::SEARCH: {
+                    const search::Result searched = searcher_->Search(
+                        board, {}, limits_, stop_, search::IterationCallback());
+                    length += std::snprintf(line + length, sizeof(line) - length, " %d %s\n",
+                                            searched.score,
+                                            searched.best_move.ToString().c_str());
+                    break;
+                }
+            }
+
+            result.text.append(line, length);
+            result.positions++;
+        }
+
+        const Options& options_;                      ///< The options of the analysis.
+        BoardArea board_;                             ///< The board EPD lines are loaded on.
+        std::unique_ptr<TranspositionTable> table_;   ///< The table of the searcher, if any.
+        std::unique_ptr<search::Searcher> searcher_;  ///< The searcher, for searches only.
+        search::Limits limits_;                       ///< The limits of every search.
+        const std::atomic<bool> stop_{false};         ///< Never set, searches run to depth.
+    };
+
+    /**
+     * @brief       Finds the end of a chunk of the input.
+     *
+     * Chunks end at the end of a line, and for PGN right before the tags of a game, so that no
+     * line or game is split between chunks.
+     *
+     * @param[in]   begin   The first character of the chunk.
+     * @param[in]   end     The end of the input.
+     * @param[in]   size    The size the chunk should have at least.
+     * @param[in]   format  The format of the input.
+     *
+     * @return      One past the last character of the chunk.
+     */
+    const char* FindChunkEnd(const char* begin, const char* end, std::size_t size,
+                             Format format) noexcept
+    {
+        if (static_cast<std::size_t>(end - begin) <= size) {
+            return end;
+        }
+
+        for (const char* cursor = begin + size; cursor != end;) {
+            const char* newline =
+                static_cast<const char*>(std::memchr(cursor, '\n', end - cursor));
+            if (newline == nullptr) {
+                return end;
+            }
+            cursor = newline + 1;
+
+            if (format == Format::EPD) {
+                return cursor;
+            }
+            if (cursor == end || *cursor != '[') {
+                continue;
+            }
+
+            // A tag starts a game unless it follows another tag of the same game.
+            const char* previous = newline;
+            while (previous != begin && std::strchr(" \t\r\n", previous[-1]) != nullptr) {
+                previous--;
+            }
+            while (previous != begin && previous[-1] != '\n') {
+                previous--;
+            }
+            if (*previous != '[') {
+                return cursor;
+            }
+        }
+
+        return end;
+    }
+}  // namespace
+
+Summary batch::Run(const char* text, std::size_t length, std::FILE* output,
+                   const Options& options) noexcept
+{
+    const unsigned int thread_count = (options.thread_count > 0 ? options.thread_count : 1);
+    const std::size_t chunk_size = (options.chunk_kb > 0 ? options.chunk_kb : 1) * 1024;
+
+    BoundedQueue<Job> jobs(thread_count * kChunksPerThread);
+    BoundedQueue<std::future<ChunkResult>> pending(thread_count * kChunksPerThread);
+
+    // A chunk's future is queued before the chunk itself, so the writer never waits for a chunk
+    // the workers can't get to.
+    std::thread splitter([&] {
+        const char* const end = text + length;
+        for (const char* begin = text; begin != end;) {
+            Job job;
+            job.begin = begin;
+            job.end = FindChunkEnd(begin, end, chunk_size, options.format);
+            begin = job.end;
+
+            pending.Push(job.result.get_future());
+            jobs.Push(std::move(job));
+        }
+        jobs.Close();
+        pending.Close();
+    });
+
+    std::vector<std::thread> workers;
+    for (unsigned int i = 0; i < thread_count; i++) {
+        workers.emplace_back([&] {
+            Worker worker(options);
+            Job job;
+            while (jobs.Pop(job)) {
+                job.result.set_value(worker.Analyse(job.begin, job.end));
+            }
+        });
+    }
+
+    Summary summary;
+    std::future<ChunkResult> future;
+    while (pending.Pop(future)) {
+        const ChunkResult result = future.get();
+        std::fwrite(result.text.data(), 1, result.text.size(), output);
+        summary.positions += result.positions;
+        summary.skipped += result.skipped;
+    }
+
+    splitter.join();
+    for (auto& worker : workers) {
+        worker.join();
+    }
+
+    return summary;
+}
@@ -0,0 +1,80 @@
+/**
+ * @file    batch_pipeline.hpp
+ *
+ * @brief   Parallel analysis of position collections.
+ *
+ * @section DESCRIPTION
+ *
+ * The input is split into chunks of whole games or lines, which a pool of worker threads
+ * analyses. The results are written in input order. Only a few chunks are in flight at any time,
+ * so memory use doesn't grow with the size of the input.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+
+namespace raychess
+{
+    namespace batch
+    {
+        /**
+         * @brief   The format of the input.
+         */
+        enum class Format
+        {
+            EPD,  ///< One position per line, in FEN or EPD.
+            PGN   ///< Games, every position before a move is analysed.
+        };
+
+        /**
+         * @brief   What is worked out for every position.
+         */
+        enum class Analysis
+        {
+            MOVES,     ///< The number of legal moves.
+            MATERIAL,  ///< The material balance in points, positive if White is ahead.
+            SEARCH     ///< The score and best move of a fixed depth search.
+        };
+
+        /**
+         * @brief   Options of a batch analysis.
+         */
+        struct Options
+        {
+            Format format = Format::EPD;          ///< The format of the input.
+            Analysis analysis = Analysis::MOVES;  ///< What is worked out for every position.
+            unsigned int thread_count = 1;        ///< Number of worker threads.
+            int depth = 6;                        ///< Depth of the searches.
+            std::size_t hash_mb = 16;             ///< Table size of every worker, in MB.
+            std::size_t chunk_kb = 256;           ///< Size of the input chunks, in KB.
+        };
+
+        /**
+         * @brief   Totals of a batch analysis.
+         */
+        struct Summary
+        {
+            std::uint64_t positions = 0;  ///< Number of positions analysed.
+            std::uint64_t skipped = 0;    ///< Number of lines or games which couldn't be read.
+        };
+
+        /**
+         * @brief       Analyses every position of a text.
+         *
+         * Writes one line per position, its FEN followed by the result of the analysis, in the
+         * order of the input. Lines and games which can't be read are skipped.
+         *
+         * @param[in]   text     The input text.
+         * @param[in]   length   The length of the text.
+         * @param[in]   output   The stream to write the results to.
+         * @param[in]   options  The options of the analysis.
+         *
+         * @return      The totals of the analysis.
+         */
+        Summary Run(const char* text, std::size_t length, std::FILE* output,
+                    const Options& options) noexcept;
+    }  // namespace batch
+}  // namespace raychess
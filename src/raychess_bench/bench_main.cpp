@@ -0,0 +1,67 @@
+/**
+ * @file    bench_main.cpp
+ *
+ * @brief   Entry point of the benchmarks executable.
+ *
+ * @section DESCRIPTION
+ *
+ * Runs one of the benchmarks of the core game library, selected by the first argument.
+ */
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#include "benchmarks.hpp"
+
+using namespace raychess;
+
+namespace
+{
+    /**
+     * @brief       Prints the usage of the executable.
+     *
+     * @param[in]   program  Name of the executable.
+     */
+    void PrintUsage(const char* program) noexcept
+    {
+        std::printf("Usage: %s <benchmark> [arguments]\n\n", program);
+        std::printf("Benchmarks:\n");
+        std::printf("  packed <pgn> <out>        Position file size and loading speed vs. FEN\n");
+        std::printf("  pgn <file>                PGN reading and replay speed\n");
+        std::printf("  probe [iterations]        Square probe cost, linear scan vs. BoardArea\n");
+        std::printf("  search [threads] [depth]  Search speed in total and per thread\n");
+    }
+}  // namespace
+
+int main(int argc, char* argv[])
+{
+    if (argc < 2) {
+        PrintUsage(argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    if (std::strcmp(argv[1], "packed") == 0 && argc > 3) {
+        return benchmarks::RunPackedBenchmark(argv[2], argv[3]);
+    }
+
+    if (std::strcmp(argv[1], "pgn") == 0 && argc > 2) {
+        return benchmarks::RunPgnBenchmark(argv[2]);
+    }
+
+    if (std::strcmp(argv[1], "probe") == 0) {
+        const long iterations = (argc > 2 ? std::atol(argv[2]) : 1000000);
+        return benchmarks::RunProbeBenchmark(iterations);
+    }
+
+    if (std::strcmp(argv[1], "search") == 0) {
+        const int threads = (argc > 2 ? std::atoi(argv[2]) : 1);
+        const int depth = (argc > 3 ? std::atoi(argv[3]) : 8);
+        return benchmarks::RunSearchBenchmark(static_cast<unsigned int>(std::max(threads, 1)),
+                                              depth);
+    }
+
+    PrintUsage(argv[0]);
+    return EXIT_FAILURE;
+}
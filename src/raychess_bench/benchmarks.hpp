@@ -0,0 +1,69 @@
+/**
+ * @file    benchmarks.hpp
+ *
+ * @brief   Benchmarks of the core game library.
+ *
+ * @section DESCRIPTION
+ *
+ * Declares the individual benchmarks runnable by the benchmarks executable. Each benchmark prints
+ * its own results to the standard output.
+ */
+
+#pragma once
+
+namespace raychess
+{
+    namespace benchmarks
+    {
+        /**
+         * @brief       Measures the cost of probing board squares for pieces.
+         *
+         * Compares the linear scan over the piece collections the board used to perform with the
+         * square table and bitboard backed queries of BoardArea, using the starting position.
+         *
+         * @param[in]   iterations  Number of times every square is probed.
+         *
+         * @return      Zero on success, non-zero otherwise.
+         */
+        int RunProbeBenchmark(long iterations) noexcept;
+
+        /**
+         * @brief       Measures the speed of reading and replaying a PGN archive.
+         *
+         * Maps the archive into memory and replays every game on a board, reporting the games
+         * and positions per second and the throughput of the file.
+         *
+         * @param[in]   path  Path of the PGN archive.
+         *
+         * @return      Zero on success, non-zero otherwise.
+         */
+        int RunPgnBenchmark(const char* path) noexcept;
+
+        /**
+         * @brief       Measures the cost of storing and loading packed positions.
+         *
+         * Writes every position of a PGN archive to a position file, then loads all of them back
+         * both from the file and from FEN strings, comparing the size and loading speed of the
+         * two.
+         *
+         * @param[in]   pgn_path       Path of the PGN archive.
+         * @param[in]   position_path  Path of the position file to write.
+         *
+         * @return      Zero on success, non-zero otherwise.
+         */
+        int RunPackedBenchmark(const char* pgn_path, const char* position_path) noexcept;
+
+        /**
+         * @brief       Measures the speed of the parallel search.
+         *
+         * Searches a few positions to a fixed depth and reports the nodes per second of the whole
+         * search and of every thread.
+         *
+         * @param[in]   thread_count  Number of threads to search with.
+         * @param[in]   depth         Depth to search every position to.
+         *
+         * @return      Zero on success, non-zero otherwise.
+         */
+        int RunSearchBenchmark(unsigned int thread_count, int depth) noexcept;
+    }  // namespace benchmarks
+}  // namespace raychess
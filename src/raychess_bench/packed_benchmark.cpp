@@ -0,0 +1,121 @@
+/**
+ * @file    packed_benchmark.cpp
+ *
+ * @brief   Benchmark of the packed position format.
+ *
+ * @section DESCRIPTION
+ *
+ * Compares position files with FEN strings, in size and in how fast positions are loaded from
+ * them.
+ */
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string>
+
+#include "benchmarks.hpp"
+#include "board_area.hpp"
+#include "fen.hpp"
+#include "mapped_file.hpp"
+#include "pgn.hpp"
+#include "position_file.hpp"
+
+using namespace raychess;
+
+namespace
+{
+    /**
+     * @brief       Gets the seconds passed since a point in time.
+     *
+     * @param[in]   start  The point in time.
+     *
+     * @return      The seconds passed.
+     */
+    double SecondsSince(std::chrono::steady_clock::time_point start) noexcept
+    {
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    }
+}  // namespace
+
+int benchmarks::RunPackedBenchmark(const char* pgn_path, const char* position_path) noexcept
+{
+    MappedFile archive;
+    PositionFileWriter writer;
+    if (!archive.Open(pgn_path) || !writer.Open(position_path)) {
+        std::printf("Cannot open %s or create %s\n", pgn_path, position_path);
+        return 1;
+    }
+
+    // The FEN strings are kept back to back, so that loading them isn't slowed by allocations.
+    std::string fens;
+    pgn::Reader reader(archive.GetData(), archive.GetSize());
+    pgn::Game game;
+    const auto callback = [&writer, &fens](const BoardArea& board, Move) {
+        char fen[fen::kMaxLength];
+        const std::size_t length = fen::SavePosition(board, fen);
+
+        writer.Append(board);
+        fens.append(fen, length + 1);
+    };
+
+    // The reader only passes the positions of games it read completely, each game's positions
+    // within a single ReadGame() call, so every game is started before its first position.
+    auto start = std::chrono::steady_clock::now();
+    writer.StartGame();
+    while (reader.ReadGame(game, callback)) {
+        writer.StartGame();
+    }
+    if (!writer.Close()) {
+        std::printf("Cannot write %s\n", position_path);
+        return 1;
+    }
+    std::printf("Wrote %s in %.3f s\n", position_path, SecondsSince(start));
+
+    PositionFile file;
+    if (!file.Open(position_path)) {
+        std::printf("Cannot read %s\n", position_path);
+        return 1;
+    }
+
+    const std::uint64_t count = file.GetPositionCount();
+    std::printf("%llu positions of %llu games: %.1f MB packed, %.1f MB as FEN\n",
+                static_cast<unsigned long long>(count),
+                static_cast<unsigned long long>(file.GetGameCount()),
+                count * sizeof(PackedPosition) / (1024.0 * 1024.0),
+                fens.size() / (1024.0 * 1024.0));
+
+    if (count == 0) {
+        return 0;
+    }
+
+    BoardArea board(8, 8);
+    std::uint64_t checksum = 0;
+
+    start = std::chrono::steady_clock::now();
+    for (std::uint64_t i = 0; i < count; i++) {
+        file.LoadPosition(board, i);
+        checksum += board.GetKey();
+    }
+    const double packed_seconds = SecondsSince(start);
+
+    start = std::chrono::steady_clock::now();
+    for (const char* fen = fens.c_str(); fen != fens.c_str() + fens.size();
+         fen += std::strlen(fen) + 1) {
+        fen::LoadPosition(board, fen);
+        checksum -= board.GetKey();
+    }
+    const double fen_seconds = SecondsSince(start);
+
+    std::printf("Packed: %8.1f ns per position\n", packed_seconds * 1e9 / count);
+    std::printf("FEN:    %8.1f ns per position\n", fen_seconds * 1e9 / count);
+
+    // Both formats hold the same positions, so the keys cancel out.
+    if (checksum != 0) {
+        std::printf("The packed positions differ from the FEN strings\n");
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,53 @@
+/**
+ * @file    pgn_benchmark.cpp
+ *
+ * @brief   Benchmark of reading PGN archives.
+ *
+ * @section DESCRIPTION
+ *
+ * Measures how fast games are read from a PGN archive and replayed, which bounds how fast an
+ * archive can be fed through the engine.
+ */
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+
+#include "benchmarks.hpp"
+#include "mapped_file.hpp"
+#include "pgn.hpp"
+
+using namespace raychess;
+
+int benchmarks::RunPgnBenchmark(const char* path) noexcept
+{
+    MappedFile file;
+    if (!file.Open(path)) {
+        std::printf("Cannot open %s\n", path);
+        return 1;
+    }
+
+    std::printf("Reading %s (%.1f MB)\n", path, file.GetSize() / (1024.0 * 1024.0));
+
+    const auto start = std::chrono::steady_clock::now();
+
+    pgn::Reader reader(file.GetData(), file.GetSize());
+    pgn::Game game;
+    std::uint64_t games = 0;
+    std::uint64_t positions = 0;
+    while (reader.ReadGame(game)) {
+        games++;
+        positions += game.moves.size();
+    }
+
+    const double seconds =
+        std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    std::printf("%llu games (%zu skipped), %llu positions in %.3f s\n",
+                static_cast<unsigned long long>(games), reader.GetSkippedGames(),
+                static_cast<unsigned long long>(positions), seconds);
+    std::printf("%.0f games/s, %.0f positions/s, %.1f MB/s\n", games / seconds,
+                positions / seconds, file.GetSize() / (1024.0 * 1024.0) / seconds);
+
+    return 0;
+}
@@ -0,0 +1,151 @@
+/**
+ * @file    probe_benchmark.cpp
+ *
+ * @brief   Benchmark of square probes on the board.
+ *
+ * @section DESCRIPTION
+ *
+ * Measures how long it takes to find out what occupies a square of the board.
+ */
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <vector>
+
+#include "benchmarks.hpp"
+#include "bishop.hpp"
+#include "board_area.hpp"
+#include "king.hpp"
+#include "knight.hpp"
+#include "pawn.hpp"
+#include "queen.hpp"
+#include "rook.hpp"
+
+using namespace raychess;
+
+namespace
+{
+    /**
+     * @brief       Fills the board with the pieces of the starting position.
+     *
+     * @param[out]  board  The board to fill.
+     */
+    void SetUpStartingPosition(BoardArea& board) noexcept
+    {
+        const PieceBase::PieceColour colours[] = {PieceBase::PieceColour::WHITE,
+                                                  PieceBase::PieceColour::BLACK};
+
+        for (const auto colour : colours) {
+            const int back_rank = (colour == PieceBase::PieceColour::WHITE ? 0 : 7);
+            const int pawn_rank = (colour == PieceBase::PieceColour::WHITE ? 1 : 6);
+
+            for (int x = 0; x < 8; x++) {
+                Pawn pawn(colour, Position2D(x, pawn_rank));
+                board.AddPiece(pawn);
+            }
+
+            Rook queen_rook(colour, Position2D(0, back_rank));
+            Knight queen_knight(colour, Position2D(1, back_rank));
+            Bishop queen_bishop(colour, Position2D(2, back_rank));
+            Queen queen(colour, Position2D(3, back_rank));
+            King king(colour, Position2D(4, back_rank));
+            Bishop king_bishop(colour, Position2D(5, back_rank));
+            Knight king_knight(colour, Position2D(6, back_rank));
+            Rook king_rook(colour, Position2D(7, back_rank));
+
+            board.AddPiece(queen_rook);
+            board.AddPiece(queen_knight);
+            board.AddPiece(queen_bishop);
+            board.AddPiece(queen);
+            board.AddPiece(king);
+            board.AddPiece(king_bishop);
+            board.AddPiece(king_knight);
+            board.AddPiece(king_rook);
+        }
+    }
+
+    /**
+     * @brief       Finds a piece the way the board used to, scanning both piece collections.
+     *
+     * @param[in]   board     The board to search.
+     * @param[in]   position  The position to get the piece at.
+     *
+     * @return      A pointer to the piece at the given position, or nullptr if there is none.
+     */
+    const PieceBase* ScanForPieceAt(const BoardArea& board, const Position2D& position) noexcept
+    {
+        for (const auto& piece : board.GetPiecesByColour(PieceBase::PieceColour::WHITE)) {
+            if (piece->GetPosition() == position) {
+                return piece.get();
+            }
+        }
+        for (const auto& piece : board.GetPiecesByColour(PieceBase::PieceColour::BLACK)) {
+            if (piece->GetPosition() == position) {
+                return piece.get();
+            }
+        }
+        return nullptr;
+    }
+
+    /**
+     * @brief       Times a probe over every square of the board.
+     *
+     * @param[in]   name        Name of the probe, used in the report.
+     * @param[in]   iterations  Number of times every square is probed.
+     * @param[in]   probe       The probe, returning a value that depends on the probed square.
+     */
+    template <typename Probe>
+    void TimeProbe(const char* name, long iterations, Probe probe) noexcept
+    {
+        unsigned long checksum = 0;
+
+        const auto start = std::chrono::steady_clock::now();
+        for (long i = 0; i < iterations; i++) {
+            // Keeps the compiler from noticing that the board doesn't change between iterations
+            // and probing it only once.
+            std::atomic_signal_fence(std::memory_order_seq_cst);
+            for (int y = 0; y < 8; y++) {
+                for (int x = 0; x < 8; x++) {
+                    checksum += probe(Position2D(x, y));
+                }
+            }
+        }
+        const auto end = std::chrono::steady_clock::now();
+
+        const double nanoseconds = std::chrono::duration<double, std::nano>(end - start).count();
+        std::printf("%-28s %8.2f ns/probe  (checksum %lu)\n", name,
+                    nanoseconds / (static_cast<double>(iterations) * 64.0), checksum);
+    }
+}  // namespace
+
+int benchmarks::RunProbeBenchmark(long iterations) noexcept
+{
+    BoardArea board(8, 8);
+    SetUpStartingPosition(board);
+
+    std::printf("Probing all 64 squares of the starting position %ld times\n", iterations);
+
+    TimeProbe("piece lookup, linear scan", iterations, [&board](const Position2D& position) {
+        return static_cast<unsigned long>(ScanForPieceAt(board, position) != nullptr);
+    });
+    TimeProbe("piece lookup, piece objects", iterations, [&board](const Position2D& position) {
+        return static_cast<unsigned long>(board.GetPieceAt(position) != nullptr);
+    });
+    TimeProbe("piece lookup, square table", iterations, [&board](const Position2D& position) {
+        return static_cast<unsigned long>(
+            board.GetPiece(position.ToSquareIndex()) != Piece::NONE);
+    });
+    TimeProbe("colour check, linear scan", iterations, [&board](const Position2D& position) {
+        const PieceBase* piece = ScanForPieceAt(board, position);
+        return static_cast<unsigned long>(piece != nullptr &&
+                                          piece->GetColour() == PieceBase::PieceColour::WHITE);
+    });
+    TimeProbe("colour check, bitboards", iterations, [&board](const Position2D& position) {
+        return static_cast<unsigned long>(
+            board.IsOccupiedBy(position, PieceBase::PieceColour::WHITE));
+    });
+
+    return 0;
+}
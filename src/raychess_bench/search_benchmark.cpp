@@ -0,0 +1,99 @@
+/**
+ * @file    search_benchmark.cpp
+ *
+ * @brief   Benchmark of the parallel search.
+ *
+ * @section DESCRIPTION
+ *
+ * Measures how fast the search is, in total and per thread, so that its scaling with the number
+ * of threads can be followed.
+ */
+
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+
+#include "benchmarks.hpp"
+#include "board_area.hpp"
+#include "fen.hpp"
+#include "parallel_searcher.hpp"
+#include "transposition_table.hpp"
+
+using namespace raychess;
+
+namespace
+{
+    /**
+     * @brief   Positions searched by the benchmark, from the opening to the endgame.
+     */
+    const char* const kPositions[] = {
+        fen::kStartingPosition,
+        "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1",
+        "r4rk1/1pp1qppp/p1np1n2/2b1p1B1/2B1P1b1/P1NP1N2/1PP1QPPP/R4RK1 w - - 0 10",
+        "8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 1",
+    };
+}  // namespace
+
+int benchmarks::RunSearchBenchmark(unsigned int thread_count, int depth) noexcept
+{
+    TranspositionTable table(64);
+    search::ParallelSearcher searcher(table, thread_count);
+    const std::atomic<bool> stop(false);
+
+    search::Limits limits;
+    limits.depth = depth;
+
+    std::printf("Searching %zu positions to depth %d with %u thread(s)\n",
+                sizeof(kPositions) / sizeof(kPositions[0]), depth, searcher.GetThreadCount());
+
+    std::uint64_t total_nodes = 0;
+    double total_seconds = 0.0;
+    std::vector<search::ThreadReport> totals(searcher.GetThreadCount());
+
+    for (const char* position : kPositions) {
+        BoardArea board(8, 8);
+        if (!fen::LoadPosition(board, position)) {
+            std::printf("Invalid position: %s\n", position);
+            return 1;
+        }
+
+        table.Clear();
+        searcher.ClearHeuristics();
+        const search::Result result =
+            searcher.Search(board, {}, limits, stop, search::IterationCallback());
+
+        std::printf("%-6s score %6d  depth %3d  %12llu nodes  %8.3f s\n",
+                    result.best_move.ToString().c_str(), result.score, result.depth,
+                    static_cast<unsigned long long>(result.nodes), result.seconds);
+
+        total_nodes += result.nodes;
+        total_seconds += result.seconds;
+        for (std::size_t i = 0; i < totals.size(); i++) {
+            const search::ThreadReport& report = searcher.GetThreadReports()[i];
+
+            totals[i].nodes += report.nodes;
+            totals[i].pawn_hash_hits += report.pawn_hash_hits;
+            totals[i].pawn_hash_misses += report.pawn_hash_misses;
+            totals[i].table_hits += report.table_hits;
+            totals[i].table_misses += report.table_misses;
+        }
+    }
+
+    std::printf("\nTotal: %llu nodes in %.3f s, %.0f nodes/s\n",
+                static_cast<unsigned long long>(total_nodes), total_seconds,
+                total_seconds > 0.0 ? total_nodes / total_seconds : 0.0);
+    for (std::size_t i = 0; i < totals.size(); i++) {
+        const std::uint64_t probes = totals[i].pawn_hash_hits + totals[i].pawn_hash_misses;
+        const std::uint64_t table_probes = totals[i].table_hits + totals[i].table_misses;
+
+        std::printf("  thread %2zu: %12llu nodes, %.0f nodes/s, pawn hash hits %.1f%%, "
+                    "table hits %.1f%%\n",
+                    i, static_cast<unsigned long long>(totals[i].nodes),
+                    total_seconds > 0.0 ? totals[i].nodes / total_seconds : 0.0,
+                    probes > 0 ? 100.0 * totals[i].pawn_hash_hits / probes : 0.0,
+                    table_probes > 0 ? 100.0 * totals[i].table_hits / table_probes : 0.0);
+    }
+
+    return 0;
+}
@@ -0,0 +1,281 @@
+/**
+ * @file    attacks.cpp
+ *
+ * @brief   Precomputed attack tables.
+ *
+ * @section DESCRIPTION
+ *
+ * Lookup tables giving the squares a piece attacks from a given square.
+ */
+
+#include "attacks.hpp"
+
+#include <cstddef>
+
+using namespace raychess;
+
+namespace
+{
+    /**
+     * @brief       Generates the attack sets of a piece which jumps by fixed offsets.
+     *
+     * @param[in]   offsets  The (x, y) offsets the piece can jump by.
+     *
+     * @return      The attack sets of the piece, one per square.
+     */
+    template <std::size_t Count>
+    constexpr attacks::SquareTable GenerateLeaperTable(const int (&offsets)[Count][2]) noexcept
+    {
+        attacks::SquareTable table{};
+
+        for (int square = 0; square < bitboard::kSquareCount; square++) {
+            for (std::size_t i = 0; i < Count; i++) {
+                const int x = square % bitboard::kBoardSize + offsets[i][0];
+                const int y = square / bitboard::kBoardSize + offsets[i][1];
+
+                if (x >= 0 && x < bitboard::kBoardSize && y >= 0 && y < bitboard::kBoardSize) {
+                    table.squares[square] |= bitboard::SquareBit(y * bitboard::kBoardSize + x);
+                }
+            }
+        }
+
+        return table;
+    }
+
+    constexpr int kKnightOffsets[8][2] = {{1, 2},   {2, 1},   {2, -1}, {1, -2},
+                                          {-1, -2}, {-2, -1}, {-2, 1}, {-1, 2}};
+    constexpr int kKingOffsets[8][2] = {{0, 1},  {1, 1},   {1, 0},  {1, -1},
+                                        {0, -1}, {-1, -1}, {-1, 0}, {-1, 1}};
+    constexpr int kWhitePawnOffsets[2][2] = {{-1, 1}, {1, 1}};
+    constexpr int kBlackPawnOffsets[2][2] = {{-1, -1}, {1, -1}};
+}  // namespace
+
+// Defined as extern constexpr, so that the tables are computed by the compiler, yet exist only
+// once in the whole program.
+extern constexpr attacks::SquareTable attacks::knight_table = GenerateLeaperTable(kKnightOffsets);
+extern constexpr attacks::SquareTable attacks::king_table = GenerateLeaperTable(kKingOffsets);
+extern constexpr attacks::SquareTable attacks::pawn_tables[2] = {
+    GenerateLeaperTable(kWhitePawnOffsets), GenerateLeaperTable(kBlackPawnOffsets)};
+
+attacks::Magic attacks::rook_magics[bitboard::kSquareCount];
+attacks::Magic attacks::bishop_magics[bitboard::kSquareCount];
+Bitboard attacks::between_squares[bitboard::kSquareCount][bitboard::kSquareCount];
+Bitboard attacks::line_squares[bitboard::kSquareCount][bitboard::kSquareCount];
+
+namespace
+{
+    constexpr int kRookTableSize = 0x19000;   ///< Sum of all rook table sizes, 2^bits per square.
+    constexpr int kBishopTableSize = 0x1480;  ///< Sum of all bishop table sizes.
+    constexpr int kMaxSubsets = 4096;         ///< Most occupancy subsets of a single square.
+
+    Bitboard rook_table[kRookTableSize];      ///< Attack sets of all rook squares.
+    Bitboard bishop_table[kBishopTableSize];  ///< Attack sets of all bishop squares.
+
+    /**
+     * @brief   Seeds of the magic search, one per rank.
+     *
+     * Any seed leads to valid magics, these ones just happen to find them quickly.
+     */
+    const std::uint64_t kMagicSeeds[bitboard::kBoardSize] = {728,   10316, 55013, 32803,
+                                                             12281, 15100, 16645, 255};
+
+    using Direction2D = Position2D::Direction2D;
+
+    const Direction2D kRookDirections[] = {Direction2D::UP, Direction2D::DOWN, Direction2D::LEFT,
+                                           Direction2D::RIGHT};
+    const Direction2D kBishopDirections[] = {Direction2D::UP_LEFT, Direction2D::UP_RIGHT,
+                                             Direction2D::DOWN_LEFT, Direction2D::DOWN_RIGHT};
+
+    /**
+     * @brief   A small xorshift64* pseudo random number generator.
+     *
+     * The magic search only needs the numbers to be reproducible, not to be of any great quality.
+     */
+    class RandomGenerator
+    {
+    public:
+        explicit RandomGenerator(std::uint64_t seed) noexcept : state_(seed) {}
+
+        std::uint64_t Next(void) noexcept
+        {
+            state_ ^= state_ >> 12;
+            state_ ^= state_ << 25;
+            state_ ^= state_ >> 27;
+            return state_ * 2685821657736338717ULL;
+        }
+
+        /**
+         * @brief       Generates a number with only a few bits set, which makes a good magic.
+         */
+        std::uint64_t NextSparse(void) noexcept { return Next() & Next() & Next(); }
+
+    private:
+        std::uint64_t state_;
+    };
+
+    /**
+     * @brief       Computes a slider's attacks by walking each ray square by square.
+     *
+     * Slow, but obviously correct, this is the reference the attack tables are filled from.
+     *
+     * @param[in]   square      The square index of the slider.
+     * @param[in]   occupied    The occupied squares of the board.
+     * @param[in]   directions  The directions the slider moves in.
+     *
+     * @return      A bitboard of the attacked squares.
+     */
+    Bitboard SlidingAttacks(int square, Bitboard occupied,
+                            const Direction2D (&directions)[4]) noexcept
+    {
+        Bitboard attacked = bitboard::kEmpty;
+
+        for (const auto direction : directions) {
+            const Position2D step(direction);
+            Position2D position = Position2D::FromSquareIndex(square) + step;
+
+            while (position.x >= 0 && position.x < bitboard::kBoardSize && position.y >= 0 &&
+                   position.y < bitboard::kBoardSize) {
+                const int target = position.ToSquareIndex();
+
+                attacked |= bitboard::SquareBit(target);
+                // The first piece in the way blocks the rest of the ray.
+                if (bitboard::IsSet(occupied, target)) {
+                    break;
+                }
+                position += step;
+            }
+        }
+
+        return attacked;
+    }
+
+    /**
+     * @brief       Fills a slider's magics and attack table.
+     *
+     * For every square, all subsets of the relevant occupancy are enumerated, and random sparse
+     * candidates are tried until one maps every subset to an index without a destructive
+     * collision. The random generator is seeded with constants, so the search is reproducible
+     * and takes the same (short) time on every start.
+     *
+     * @param[out]  magics      The magics to fill, one per square.
+     * @param[out]  table       The attack table to fill.
+     * @param[in]   directions  The directions the slider moves in.
+     */
+    void InitialiseMagics(attacks::Magic (&magics)[bitboard::kSquareCount], Bitboard* table,
+                          const Direction2D (&directions)[4]) noexcept
+    {
+        static Bitboard occupancies[kMaxSubsets];
+        static Bitboard references[kMaxSubsets];
+#if !defined(RAYCHESS_USE_PEXT)
+        static int epochs[kMaxSubsets];
+        int current_epoch = 0;
+#endif
+        Bitboard* square_table = table;
+
+        for (int square = 0; square < bitboard::kSquareCount; square++) {
+            const Position2D position = Position2D::FromSquareIndex(square);
+            // Pieces on the edges of the board never block anything, as there are no squares
+            // behind them, so they are left out of the relevant occupancy.
+            const Bitboard edges =
+                ((bitboard::kRank1 | bitboard::kRank8) & ~bitboard::RankMask(position.y)) |
+                ((bitboard::kFileA | bitboard::kFileH) & ~bitboard::FileMask(position.x));
+
+            attacks::Magic& entry = magics[square];
+            entry.mask = SlidingAttacks(square, bitboard::kEmpty, directions) & ~edges;
+            entry.shift = static_cast<unsigned int>(64 - bitboard::PopCount(entry.mask));
+            entry.attacks = square_table;
+
+            // Enumerate all subsets of the mask (the Carry-Rippler trick).
+            int size = 0;
+            Bitboard subset = bitboard::kEmpty;
+            do {
+                occupancies[size] = subset;
+                references[size] = SlidingAttacks(square, subset, directions);
+                size++;
+                subset = (subset - entry.mask) & entry.mask;
+            } while (subset != bitboard::kEmpty);
+
+#if defined(RAYCHESS_USE_PEXT)
+            entry.magic = bitboard::kEmpty;
+            for (int i = 0; i < size; i++) {
+                square_table[entry.Index(occupancies[i])] = references[i];
+            }
+#else
+            RandomGenerator random(kMagicSeeds[position.y]);
+
+            int i;
+            do {
+                do {
+                    entry.magic = random.NextSparse();
+                } while (bitboard::PopCount((entry.magic * entry.mask) >> 56) < 6);
+
+                // Epochs tell the entries filled by this candidate apart from stale ones, so the
+                // table doesn't have to be cleared between candidates.
+                current_epoch++;
+                for (i = 0; i < size; i++) {
+                    const unsigned int index = entry.Index(occupancies[i]);
+
+                    if (epochs[index] < current_epoch) {
+                        epochs[index] = current_epoch;
+                        square_table[index] = references[i];
+                    }
+                    else if (square_table[index] != references[i]) {
+                        break;
+                    }
+                }
+            } while (i < size);
+#endif
+
+            square_table += size;
+        }
+    }
+
+    /**
+     * @brief       Fills the tables of squares between and along the lines through two squares.
+     *
+     * Relies on the slider attack tables being filled already.
+     */
+    void InitialiseLines(void) noexcept
+    {
+        for (int from = 0; from < bitboard::kSquareCount; from++) {
+            for (int to = 0; to < bitboard::kSquareCount; to++) {
+                const Bitboard ends = bitboard::SquareBit(from) | bitboard::SquareBit(to);
+                Bitboard (*slider_attacks)(int, Bitboard) = nullptr;
+
+                if (bitboard::IsSet(attacks::RookAttacks(from, bitboard::kEmpty), to)) {
+                    slider_attacks = attacks::RookAttacks;
+                }
+                else if (bitboard::IsSet(attacks::BishopAttacks(from, bitboard::kEmpty), to)) {
+                    slider_attacks = attacks::BishopAttacks;
+                }
+                else {
+                    continue;
+                }
+
+                // Two sliders on a common line attack each other's side of it, so the intersection
+                // of their attacks on an empty board is the rest of the line.
+                attacks::line_squares[from][to] = (slider_attacks(from, bitboard::kEmpty) &
+                                                   slider_attacks(to, bitboard::kEmpty)) |
+                                                  ends;
+                attacks::between_squares[from][to] =
+                    slider_attacks(from, ends) & slider_attacks(to, ends);
+            }
+        }
+    }
+
+    /**
+     * @brief   Fills all attack tables on construction.
+     */
+    struct AttackTablesInitialiser
+    {
+        AttackTablesInitialiser() noexcept
+        {
+            InitialiseMagics(attacks::rook_magics, rook_table, kRookDirections);
+            InitialiseMagics(attacks::bishop_magics, bishop_table, kBishopDirections);
+            InitialiseLines();
+        }
+    };
+
+    // The tables are defined in this file, so anything using them pulls this initialiser in too.
+    const AttackTablesInitialiser initialiser;
+}  // namespace
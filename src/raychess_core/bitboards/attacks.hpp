@@ -0,0 +1,179 @@
+/**
+ * @file    attacks.hpp
+ *
+ * @brief   Precomputed attack tables.
+ *
+ * @section DESCRIPTION
+ *
+ * Lookup tables giving the squares a piece attacks from a given square. The attacks of knights,
+ * kings and pawns don't depend on other pieces, so their tables are generated at compile time.
+ *
+ * Sliding pieces use magic bitboards: the occupancy of the squares relevant to a slider is hashed
+ * into an index into a table of precomputed attack sets, so a full attack set costs a mask, a
+ * multiply, a shift and a load. When built with RAYCHESS_USE_PEXT, the BMI2 PEXT instruction
+ * replaces the multiply and shift. These tables are initialised once, before main() is entered,
+ * together with the tables of squares between and along the lines through two squares.
+ */
+
+#pragma once
+
+#include <cstdint>
+
+#if defined(RAYCHESS_USE_PEXT)
+#include <immintrin.h>
+#endif
+
+#include "bitboard.hpp"
+#include "piece_types.hpp"
+
+namespace raychess
+{
+    namespace attacks
+    {
+        /**
+         * @brief   The attack sets of a piece, one per square.
+         */
+        struct SquareTable
+        {
+            Bitboard squares[bitboard::kSquareCount];  ///< The attack set of each square.
+        };
+
+        extern const SquareTable knight_table;    ///< Knight attacks.
+        extern const SquareTable king_table;      ///< King attacks.
+        extern const SquareTable pawn_tables[2];  ///< Pawn attacks, indexed by the pawn colour.
+
+        /**
+         * @brief       Gets the squares a knight attacks.
+         *
+         * @param[in]   square  The square index of the knight.
+         *
+         * @return      A bitboard of the attacked squares.
+         */
+        inline Bitboard KnightAttacks(int square) noexcept { return knight_table.squares[square]; }
+
+        /**
+         * @brief       Gets the squares a king attacks.
+         *
+         * @param[in]   square  The square index of the king.
+         *
+         * @return      A bitboard of the attacked squares.
+         */
+        inline Bitboard KingAttacks(int square) noexcept { return king_table.squares[square]; }
+
+        /**
+         * @brief       Gets the squares a pawn attacks, the two squares diagonally forward.
+         *
+         * @param[in]   colour  The colour of the pawn.
+         * @param[in]   square  The square index of the pawn.
+         *
+         * @return      A bitboard of the attacked squares.
+         */
+        inline Bitboard PawnAttacks(PieceColour colour, int square) noexcept
+        {
+            return pawn_tables[static_cast<int>(colour)].squares[square];
+        }
+
+        /**
+         * @brief   The magic bitboard entry of a single square.
+         */
+        struct Magic
+        {
+            Bitboard mask;            ///< The squares whose occupancy affects the attacks.
+            Bitboard magic;           ///< The magic multiplier hashing occupancies to indices.
+            const Bitboard* attacks;  ///< This square's part of the attack table.
+            unsigned int shift;       ///< The shift leaving only the index bits.
+
+            /**
+             * @brief       Computes the attack table index of an occupancy.
+             *
+             * @param[in]   occupied  The occupied squares of the board.
+             *
+             * @return      The index into this square's part of the attack table.
+             */
+            unsigned int Index(Bitboard occupied) const noexcept
+            {
+#if defined(RAYCHESS_USE_PEXT)
+                return static_cast<unsigned int>(_pext_u64(occupied, mask));
+#else
+                return static_cast<unsigned int>(((occupied & mask) * magic) >> shift);
+#endif
+            }
+        };
+
+        extern Magic rook_magics[bitboard::kSquareCount];    ///< Rook magics, one per square.
+        extern Magic bishop_magics[bitboard::kSquareCount];  ///< Bishop magics, one per square.
+
+        /**
+         * @brief       Gets the squares a rook attacks.
+         *
+         * The attack set includes the first occupied square in each direction, regardless of the
+         * colour of the piece on it.
+         *
+         * @param[in]   square    The square index of the rook.
+         * @param[in]   occupied  The occupied squares of the board.
+         *
+         * @return      A bitboard of the attacked squares.
+         */
+        inline Bitboard RookAttacks(int square, Bitboard occupied) noexcept
+        {
+            const Magic& entry = rook_magics[square];
+            return entry.attacks[entry.Index(occupied)];
+        }
+
+        /**
+         * @brief       Gets the squares a bishop attacks.
+         *
+         * @see         RookAttacks(int square, Bitboard occupied)
+         *
+         * @param[in]   square    The square index of the bishop.
+         * @param[in]   occupied  The occupied squares of the board.
+         *
+         * @return      A bitboard of the attacked squares.
+         */
+        inline Bitboard BishopAttacks(int square, Bitboard occupied) noexcept
+        {
+            const Magic& entry = bishop_magics[square];
+            return entry.attacks[entry.Index(occupied)];
+        }
+
+        /**
+         * @brief       Gets the squares a queen attacks.
+         *
+         * @see         RookAttacks(int square, Bitboard occupied)
+         *
+         * @param[in]   square    The square index of the queen.
+         * @param[in]   occupied  The occupied squares of the board.
+         *
+         * @return      A bitboard of the attacked squares.
+         */
+        inline Bitboard QueenAttacks(int square, Bitboard occupied) noexcept
+        {
+            return RookAttacks(square, occupied) | BishopAttacks(square, occupied);
+        }
+
+        extern Bitboard between_squares[bitboard::kSquareCount][bitboard::kSquareCount];
+        extern Bitboard line_squares[bitboard::kSquareCount][bitboard::kSquareCount];
+
+        /**
+         * @brief       Gets the squares strictly between two squares on a common line.
+         *
+         * @param[in]   from  The first square index.
+         * @param[in]   to    The second square index.
+         *
+         * @return      A bitboard of the squares between the two, empty if the squares don't share
+         * a rank, file or diagonal.
+         */
+        inline Bitboard Between(int from, int to) noexcept { return between_squares[from][to]; }
+
+        /**
+         * @brief       Gets the whole line (rank, file or diagonal) two squares lie on.
+         *
+         * @param[in]   from  The first square index.
+         * @param[in]   to    The second square index.
+         *
+         * @return      A bitboard of the line's squares, both squares included, empty if the
+         * squares don't share a rank, file or diagonal.
+         */
+        inline Bitboard Line(int from, int to) noexcept { return line_squares[from][to]; }
+    }  // namespace attacks
+}  // namespace raychess
@@ -0,0 +1,170 @@
+/**
+ * @file    bitboard.hpp
+ *
+ * @brief   Bitboard type and the basic operations on it.
+ *
+ * @section DESCRIPTION
+ *
+ * A bitboard is a 64-bit set of squares, one bit per square of an 8x8 board. Square indices follow
+ * the same convention as Position2D, with A1 being square 0, B1 square 1 and H8 square 63.
+ */
+
+#pragma once
+
+#include <cstdint>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+#include "pos2d.hpp"
+
+namespace raychess
+{
+    /**
+     * @brief   A set of squares, one bit per square.
+     */
+    using Bitboard = std::uint64_t;
+
+    /**
+     * @brief   Bitboard related constants and helper functions.
+     */
+    namespace bitboard
+    {
+        constexpr int kBoardSize = 8;        ///< Number of files (and ranks) a bitboard covers.
+        constexpr int kSquareCount = 64;     ///< Number of squares a bitboard covers.
+        constexpr Bitboard kEmpty = 0;       ///< A bitboard with no squares set.
+        constexpr Bitboard kFull = ~kEmpty;  ///< A bitboard with all squares set.
+
+        static_assert(kBoardSize == Position2D::kBoardSize,
+                      "Bitboard squares are numbered like Position2D square indices");
+
+        constexpr Bitboard kFileA = 0x0101010101010101ULL;  ///< The squares of the A file.
+        constexpr Bitboard kFileH = kFileA << 7;            ///< The squares of the H file.
+        constexpr Bitboard kRank1 = 0xffULL;                ///< The squares of the first rank.
+        constexpr Bitboard kRank8 = kRank1 << 56;           ///< The squares of the eighth rank.
+
+        /**
+         * @brief       Gets a bitboard with only the given square set.
+         *
+         * @param[in]   square  The square index.
+         *
+         * @return      A bitboard with only the given square set.
+         */
+        constexpr Bitboard SquareBit(int square) noexcept { return Bitboard(1) << square; }
+
+        /**
+         * @brief       Gets a bitboard with all squares of a file set.
+         *
+         * @param[in]   file  The file index, 0 being the A file.
+         *
+         * @return      A bitboard of the file's squares.
+         */
+        constexpr Bitboard FileMask(int file) noexcept { return kFileA << file; }
+
+        /**
+         * @brief       Gets a bitboard with all squares of a rank set.
+         *
+         * @param[in]   rank  The rank index, 0 being the first rank.
+         *
+         * @return      A bitboard of the rank's squares.
+         */
+        constexpr Bitboard RankMask(int rank) noexcept { return kRank1 << (rank * kBoardSize); }
+
+        /**
+         * @brief       Checks whether a square is set in a bitboard.
+         *
+         * @param[in]   board   The bitboard to check.
+         * @param[in]   square  The square index.
+         *
+         * @return      True if the square is set, false otherwise.
+         */
+        constexpr bool IsSet(Bitboard board, int square) noexcept
+        {
+            return (board & SquareBit(square)) != kEmpty;
+        }
+
+        /**
+         * @brief       Counts the squares set in a bitboard.
+         *
+         * @param[in]   board  The bitboard.
+         *
+         * @return      The number of squares set.
+         */
+        inline int PopCount(Bitboard board) noexcept
+        {
+#if defined(__GNUC__) || defined(__clang__)
+            return __builtin_popcountll(board);
+#elif defined(_MSC_VER) && defined(_M_X64)
+            return static_cast<int>(__popcnt64(board));
+#else
+            int count = 0;
+            for (; board != kEmpty; board &= board - 1) {
+                count++;
+            }
+            return count;
+#endif
+        }
+
+        /**
+         * @brief       Gets the index of the least significant square set in a bitboard.
+         *
+         * The bitboard must not be empty.
+         *
+         * @param[in]   board  The bitboard.
+         *
+         * @return      The index of the least significant square set.
+         */
+        inline int LsbIndex(Bitboard board) noexcept
+        {
+#if defined(__GNUC__) || defined(__clang__)
+            return __builtin_ctzll(board);
+#elif defined(_MSC_VER) && defined(_M_X64)
+            unsigned long index;
+            _BitScanForward64(&index, board);
+            return static_cast<int>(index);
+#else
+            int index = 0;
+            while ((board & 1) == 0) {
+                board >>= 1;
+                index++;
+            }
+            return index;
+#endif
+        }
+
+        /**
+         * @brief       Removes the least significant square from a bitboard and returns its index.
+         *
+         * The bitboard must not be empty.
+         *
+         * @param[in,out]   board  The bitboard.
+         *
+         * @return      The index of the removed square.
+         */
+        inline int PopLsb(Bitboard& board) noexcept
+        {
+            const int index = LsbIndex(board);
+            board &= board - 1;
+            return index;
+        }
+
+        /**
+         * @brief       Shifts all squares of a bitboard by the same number of squares.
+         *
+         * Squares shifted off the board are lost. Squares are not kept from wrapping around to
+         * the other side of the board, the caller has to mask out the files that would wrap.
+         *
+         * @tparam      offset  The number of squares to shift by, up the board if positive.
+         *
+         * @param[in]   board  The bitboard.
+         *
+         * @return      The shifted bitboard.
+         */
+        template <int offset>
+        constexpr Bitboard Shift(Bitboard board) noexcept
+        {
+            return offset >= 0 ? board << (offset & 63) : board >> (-offset & 63);
+        }
+    }  // namespace bitboard
+}  // namespace raychess
@@ -10,4 +10,163 @@
 
 #include "game.hpp"
 
+#include <algorithm>
+
+#include "fen.hpp"
+#include "move_generator.hpp"
+
 using namespace raychess;
+
+Game::Game(std::size_t hash_mb, unsigned int thread_count) noexcept
+    : board_(8, 8),
+      table_(hash_mb),
+      searcher_(table_, thread_count),
+      stop_(false),
+      searching_(false)
+{
+    fen::LoadPosition(board_, fen::kStartingPosition);
+}
+
+Game::~Game()
+{
+    StopSearch();
+}
+
+bool Game::LoadPosition(const std::string& fen) noexcept
+{
+    StopSearch();
+
+    // The FEN is checked on a scratch board first, as a failed load would clear the game.
+    BoardArea board(8, 8);
+    if (!fen::LoadPosition(board, fen)) {
+        return false;
+    }
+    fen::LoadPosition(board_, fen);
+
+    // The history is kept, a GUI sends every move of a game as a new position. ClearHash()
+    // forgets it at the start of a new game.
+    keys_.clear();
+    return true;
+}
+
+bool Game::MakeMove(Move move) noexcept
+{
+    StopSearch();
+
+    MoveList moves;
+    GetLegalMoves(moves);
+    if (std::find(moves.begin(), moves.end(), move) == moves.end()) {
+        return false;
+    }
+
+    keys_.push_back(board_.GetKey());
+    board_.ApplyMove(move);
+    return true;
+}
+
+void Game::GetLegalMoves(MoveList& moves) const noexcept
+{
+    MoveGenerator(board_).GenerateMoves(moves);
+}
+
+search::Result Game::Search(const search::Limits& limits) noexcept
+{
+    StopSearch();
+
+    table_.NewSearch();
+    stop_ = false;
+    return searcher_.Search(board_, keys_, limits, stop_, search::IterationCallback());
+}
+
+void Game::StartSearch(const search::Limits& limits, const search::IterationCallback& on_iteration,
+                       const search::IterationCallback& on_finish) noexcept
+{
+    StopSearch();
+
+    {
+        std::lock_guard<std::mutex> lock(result_mutex_);
+        result_ = search::Result();
+    }
+
+    table_.NewSearch();
+    stop_ = false;
+    searching_ = true;
+
+    search_thread_ = std::thread([this, limits, on_iteration, on_finish]() {
+        const auto publish = [this, &on_iteration](const search::Result& result) {
+            {
+                std::lock_guard<std::mutex> lock(result_mutex_);
+                result_ = result;
+            }
+            if (on_iteration) {
+                on_iteration(result);
+            }
+        };
+
+        const search::Result result = searcher_.Search(board_, keys_, limits, stop_, publish);
+
+        {
+            std::lock_guard<std::mutex> lock(result_mutex_);
+            result_ = result;
+            searching_ = false;
+        }
+        if (on_finish) {
+            on_finish(result);
+        }
+        finished_.notify_all();
+    });
+}
+
+void Game::StopSearch(void) noexcept
+{
+    stop_ = true;
+    JoinSearch();
+}
+
+void Game::WaitForSearch(void) noexcept
+{
+    {
+        std::unique_lock<std::mutex> lock(result_mutex_);
+        finished_.wait(lock, [this]() { return !searching_.load(); });
+    }
+    JoinSearch();
+}
+
+search::Result Game::GetSearchResult(void) const noexcept
+{
+    std::lock_guard<std::mutex> lock(result_mutex_);
+    return result_;
+}
+
+void Game::SetThreadCount(unsigned int thread_count) noexcept
+{
+    StopSearch();
+    searcher_.SetThreadCount(thread_count);
+}
+
+bool Game::SetHashSize(std::size_t hash_mb) noexcept
+{
+    StopSearch();
+    return table_.Resize(hash_mb);
+}
+
+void Game::ClearHash(void) noexcept
+{
+    StopSearch();
+    table_.Clear();
+    searcher_.ClearHeuristics();
+}
+
+std::vector<search::ThreadReport> Game::GetThreadReports(void) const noexcept
+{
+    // The reports are written by the search thread when it finishes.
+    std::lock_guard<std::mutex> lock(result_mutex_);
+    return searching_ ? std::vector<search::ThreadReport>() : searcher_.GetThreadReports();
+}
+
+void Game::JoinSearch(void) noexcept
+{
+    if (search_thread_.joinable()) {
+        search_thread_.join();
+    }
+}
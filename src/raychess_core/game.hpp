@@ -1,5 +1,5 @@
 /**
- * @file    game.cpp
+ * @file    game.hpp
  *
  * @brief   The core code of a chess game.
  *
@@ -10,6 +10,205 @@
 
 #pragma once
 
-namespace raychess {
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
 
-}
+#include "board_area.hpp"
+#include "move.hpp"
+#include "move_list.hpp"
+#include "parallel_searcher.hpp"
+#include "searcher.hpp"
+#include "transposition_table.hpp"
+
+namespace raychess
+{
+    /**
+     * @brief   A game of chess, played by people or against the computer.
+     *
+     * The game keeps the position, the keys of the positions played before it (to recognise
+     * repetitions) and the computer opponent. The computer searches in a thread of its own, so
+     * that whoever drives the game (the UI loop in particular) can go on while it thinks and poll
+     * for the result.
+     */
+    class Game
+    {
+    public:
+        /**
+         * @brief       Constructor. The game starts in the starting position.
+         *
+         * @param[in]   hash_mb       The size of the computer's transposition table in MB.
+         * @param[in]   thread_count  The number of threads the computer searches with.
+         */
+        explicit Game(std::size_t hash_mb = TranspositionTable::kDefaultSizeMb,
+                      unsigned int thread_count = 1) noexcept;
+
+        /**
+         * @brief       Destructor. Stops the computer if it's thinking.
+         */
+        ~Game();
+
+        Game(const Game&) = delete;
+        Game& operator=(const Game&) = delete;
+
+        /**
+         * @brief       Starts a new game from a position.
+         *
+         * What the computer learnt in earlier searches is kept, see ClearHash().
+         *
+         * @param[in]   fen  The position in the Forsyth-Edwards Notation.
+         *
+         * @return      True if the position was read successfully, false otherwise. The game is
+         * left unchanged on failure.
+         */
+        bool LoadPosition(const std::string& fen) noexcept;
+
+        /**
+         * @brief       Plays a move.
+         *
+         * @param[in]   move  The move to play.
+         *
+         * @return      True if the move is legal and was played, false otherwise.
+         */
+        bool MakeMove(Move move) noexcept;
+
+        /**
+         * @brief       Generates the legal moves of the current position.
+         *
+         * @param[out]  moves  The list the moves are added to.
+         */
+        void GetLegalMoves(MoveList& moves) const noexcept;
+
+        /**
+         * @brief       Board getter.
+         *
+         * @return      The board holding the current position.
+         */
+        const BoardArea& GetBoard(void) const noexcept { return board_; }
+
+        /**
+         * @brief       Searches the current position for the best move, blocking until done.
+         *
+         * @param[in]   limits  The limits of the search.
+         *
+         * @return      The result of the search.
+         */
+        search::Result Search(const search::Limits& limits) noexcept;
+
+        /**
+         * @brief       Starts searching the current position in the background.
+         *
+         * A search already running is stopped first. The game mustn't be changed until the
+         * search finishes or is stopped.
+         *
+         * Both callbacks are called from the search thread. The finish callback is called once
+         * the search reaches its limits or is stopped, before StopSearch() returns.
+         *
+         * @param[in]   limits        The limits of the search.
+         * @param[in]   on_iteration  Function called with the result of every completed iteration.
+         * @param[in]   on_finish     Function called with the final result of the search.
+         */
+        void StartSearch(
+            const search::Limits& limits,
+            const search::IterationCallback& on_iteration = search::IterationCallback(),
+            const search::IterationCallback& on_finish = search::IterationCallback()) noexcept;
+
+        /**
+         * @brief       Stops the background search and waits for it to finish.
+         */
+        void StopSearch(void) noexcept;
+
+        /**
+         * @brief       Waits until the background search reaches its limits.
+         */
+        void WaitForSearch(void) noexcept;
+
+        /**
+         * @brief       Checks whether the background search is still running.
+         *
+         * @return      True if the search is running, false otherwise.
+         */
+        bool IsSearching(void) const noexcept { return searching_.load(); }
+
+        /**
+         * @brief       Gets the result of the background search so far.
+         *
+         * While the search runs, this is the result of its last completed iteration.
+         *
+         * @return      The result.
+         */
+        search::Result GetSearchResult(void) const noexcept;
+
+        /**
+         * @brief       Changes the number of threads the computer searches with.
+         *
+         * Stops the background search, if any.
+         *
+         * @param[in]   thread_count  The number of threads, at least 1.
+         */
+        void SetThreadCount(unsigned int thread_count) noexcept;
+
+        /**
+         * @brief       Thread count getter.
+         *
+         * @return      The number of threads the computer searches with.
+         */
+        unsigned int GetThreadCount(void) const noexcept { return searcher_.GetThreadCount(); }
+
+        /**
+         * @brief       Changes the size of the computer's transposition table, clearing it.
+         *
+         * Stops the background search, if any.
+         *
+         * @param[in]   hash_mb  The size of the table in MB.
+         *
+         * @return      True if the table got the size asked for, false if the memory couldn't be
+         * allocated and the table is smaller.
+         */
+        bool SetHashSize(std::size_t hash_mb) noexcept;
+
+        /**
+         * @brief       Hash size getter.
+         *
+         * @return      The size of the computer's transposition table in MB.
+         */
+        std::size_t GetHashSize(void) const noexcept { return table_.GetSizeMb(); }
+
+        /**
+         * @brief       Makes the computer forget what it learnt in earlier searches: the
+         * transposition table and the history.
+         *
+         * Stops the background search, if any.
+         */
+        void ClearHash(void) noexcept;
+
+        /**
+         * @brief       Gets what each thread did in the last finished search.
+         *
+         * @return      The reports, the main thread first.
+         */
+        std::vector<search::ThreadReport> GetThreadReports(void) const noexcept;
+
+    private:
+        /**
+         * @brief       Joins the background search thread, if there is one.
+         */
+        void JoinSearch(void) noexcept;
+
+        BoardArea board_;                    ///< The current position.
+        std::vector<std::uint64_t> keys_;    ///< Keys of the positions played before it.
+        TranspositionTable table_;           ///< Transposition table of the computer.
+        search::ParallelSearcher searcher_;  ///< The computer.
+
+        std::thread search_thread_;          ///< Thread of the background search.
+        std::atomic<bool> stop_;             ///< Flag stopping the background search.
+        std::atomic<bool> searching_;        ///< Whether the background search is running.
+        mutable std::mutex result_mutex_;    ///< Guards the result and the condition.
+        std::condition_variable finished_;   ///< Signalled when the background search finishes.
+        search::Result result_;              ///< The latest result of the background search.
+    };
+}  // namespace raychess
@@ -11,6 +11,7 @@
 
 #pragma once
 
+#include <memory>
 #include <vector>
 
 #include "piece_base.hpp"
@@ -30,6 +31,11 @@ namespace raychess
         AreaBase(int dimension_x, int dimension_y) noexcept
             : dimension_x_(dimension_x), dimension_y_(dimension_y){};
 
+        /**
+         * @brief       Virtual destructor, areas may be used through base class pointers.
+         */
+        virtual ~AreaBase() = default;
+
         /**
          * @brief       X-axis dimension getter.
          *
@@ -51,7 +57,7 @@ namespace raychess
          *
          * @return      A const reference to the vector of pieces in the area.
          */
-        virtual const std::vector<PieceBase>& GetPiecesByColour(
+        virtual const std::vector<std::unique_ptr<PieceBase>>& GetPiecesByColour(
             PieceBase::PieceColour which_colour) const noexcept = 0;
 
         /**
@@ -60,6 +66,7 @@ namespace raychess
          * It's up to the derived class to decide where and how to store pieces and how to add them.
          * Also, passing the colour information is unnecessary as the piece already contains this
          * information, but the derived class may not need that information in the first place.
+         * The area stores its own copy of the piece.
          *
          * @param[in]   piece  The piece to add.
          */
@@ -10,72 +10,424 @@
 
 #include "board_area.hpp"
 
+#include <algorithm>
+#include <cstring>
+#include <utility>
+
+#include "attacks.hpp"
+#include "piece_square_tables.hpp"
+
 using namespace raychess;
 
-const std::vector<PieceBase>& BoardArea::GetPiecesByColour(
-    PieceBase::PieceColour which_colour) const noexcept
+BoardArea::BoardArea(int dimension_x, int dimension_y) noexcept
+    : AreaBase(dimension_x, dimension_y), board_mask_(bitboard::kEmpty)
 {
-    if (which_colour == PieceBase::PieceColour::WHITE) {
-        return white_pieces_;
+    for (int y = 0; y < dimension_y_ && y < bitboard::kBoardSize; y++) {
+        for (int x = 0; x < dimension_x_ && x < bitboard::kBoardSize; x++) {
+            board_mask_ |= bitboard::SquareBit(Position2D(x, y).ToSquareIndex());
+        }
     }
-    else if (which_colour == PieceBase::PieceColour::BLACK) {
-        return black_pieces_;
+
+    ClearArea();
+}
+
+BoardArea::BoardArea(const BoardArea& other) noexcept
+    : AreaBase(other),
+      occupied_bitboard_(other.occupied_bitboard_),
+      board_mask_(other.board_mask_),
+      side_to_move_(other.side_to_move_),
+      castling_rights_(other.castling_rights_),
+      en_passant_square_(other.en_passant_square_),
+      halfmove_clock_(other.halfmove_clock_),
+      fullmove_number_(other.fullmove_number_),
+      key_(other.key_),
+      pawn_key_(other.pawn_key_),
+      middlegame_score_(other.middlegame_score_),
+      endgame_score_(other.endgame_score_),
+      phase_(other.phase_)
+{
+    std::memcpy(piece_bitboards_, other.piece_bitboards_, sizeof(piece_bitboards_));
+    std::memcpy(colour_bitboards_, other.colour_bitboards_, sizeof(colour_bitboards_));
+    std::memcpy(squares_, other.squares_, sizeof(squares_));
+
+    // Searches copy the board a lot and never look at the piece objects, so they are only built
+    // when asked for.
+    for (int square = 0; square < bitboard::kSquareCount; square++) {
+        piece_objects_[square] = nullptr;
+        object_squares_[square] = Piece::NONE;
     }
+    pieces_stale_.store(true, std::memory_order_relaxed);
+}
+
+const std::vector<std::unique_ptr<PieceBase>>& BoardArea::GetPiecesByColour(
+    PieceBase::PieceColour which_colour) const noexcept
+{
+    RebuildPieceObjects();
+    return pieces_[static_cast<int>(which_colour)];
 }
 
 void BoardArea::AddPiece(PieceBase& piece) noexcept
 {
-    if (piece.GetColour() == PieceBase::PieceColour::WHITE) {
-        white_pieces_.push_back(piece);
-    }
-    else if (piece.GetColour() == PieceBase::PieceColour::BLACK) {
-        black_pieces_.push_back(piece);
-    }
+    AddPiece(MakePiece(piece.GetColour(), piece.GetType()), piece.GetPosition().ToSquareIndex());
 }
 
+void BoardArea::AddPiece(Piece piece, int square) noexcept { PlacePiece(piece, square); }
+
 void BoardArea::ClearArea(void) noexcept
 {
-    white_pieces_.clear();
-    black_pieces_.clear();
+    for (auto& pieces : pieces_) {
+        pieces.clear();
+    }
+    for (int square = 0; square < bitboard::kSquareCount; square++) {
+        piece_objects_[square] = nullptr;
+        object_squares_[square] = Piece::NONE;
+    }
+    pieces_stale_.store(false, std::memory_order_relaxed);
+
+    for (auto& colour_bitboards : piece_bitboards_) {
+        for (auto& type_bitboard : colour_bitboards) {
+            type_bitboard = bitboard::kEmpty;
+        }
+    }
+    for (auto& colour_bitboard : colour_bitboards_) {
+        colour_bitboard = bitboard::kEmpty;
+    }
+    occupied_bitboard_ = bitboard::kEmpty;
+
+    for (auto& square : squares_) {
+        square = Piece::NONE;
+    }
+
+    side_to_move_ = PieceBase::PieceColour::WHITE;
+    castling_rights_ = NO_CASTLING;
+    en_passant_square_ = kNoSquare;
+    halfmove_clock_ = 0;
+    fullmove_number_ = 1;
+    key_ = zobrist::keys.castling[castling_rights_];
+    pawn_key_ = 0;
+    middlegame_score_ = 0;
+    endgame_score_ = 0;
+    phase_ = 0;
 }
 
 void BoardArea::RemovePiece(const Position2D& position, PieceBase::PieceColour colour) noexcept
 {
-    if (colour == PieceBase::PieceColour::WHITE) {
-        for (auto it = white_pieces_.begin(); it != white_pieces_.end(); ++it) {
-            if (it->GetPosition() == position) {
-                white_pieces_.erase(it);
-                break;
-            }
-        }
+    if (!IsOccupiedBy(position, colour)) {
+        return;
     }
-    else if (colour == PieceBase::PieceColour::BLACK) {
-        for (auto it = black_pieces_.begin(); it != black_pieces_.end(); ++it) {
-            if (it->GetPosition() == position) {
-                black_pieces_.erase(it);
-                break;
-            }
-        }
+
+    LiftPiece(position.ToSquareIndex());
+}
+
+void BoardArea::MovePiece(const Position2D& from, const Position2D& to) noexcept
+{
+    const int from_square = from.ToSquareIndex();
+    const int to_square = to.ToSquareIndex();
+
+    if (squares_[from_square] == Piece::NONE) {
+        return;
+    }
+
+    // Capture whatever stands on the target square first, so that the square is free to move to.
+    if (squares_[to_square] != Piece::NONE) {
+        LiftPiece(to_square);
     }
+
+    RelocatePiece(from_square, to_square);
 }
 
-const PieceBase* BoardArea::GetPieceAt(const Position2D& position) const noexcept
+void BoardArea::ApplyMove(Move move) noexcept
 {
-    for (const auto& piece : white_pieces_) {
-        if (piece.GetPosition() == position) {
-            return &piece;
-        }
+    UndoRecord undo;
+
+    MakeMove(move, undo);
+}
+
+void BoardArea::MakeMove(Move move, UndoRecord& undo) noexcept
+{
+    const int from = move.GetFrom();
+    const int to = move.GetTo();
+    const Piece piece = squares_[from];
+    const PieceBase::PieceColour colour = GetPieceColour(piece);
+    const PieceBase::PieceType type = GetPieceType(piece);
+
+    undo.key = key_;
+    undo.move = move;
+    undo.castling_rights = castling_rights_;
+    undo.en_passant_square = static_cast<std::int8_t>(en_passant_square_);
+    undo.captured = Piece::NONE;
+    undo.halfmove_clock = halfmove_clock_;
+
+    halfmove_clock_++;
+    if (type == PieceBase::PieceType::PAWN || move.IsCapture()) {
+        halfmove_clock_ = 0;
+    }
+
+    if (move.IsCapture()) {
+        // The pawn captured en passant stands beside the moving pawn, not on the target square.
+        const int captured = move.IsEnPassant() ? (from & ~7) | (to & 7) : to;
+
+        undo.captured = LiftPiece(captured);
+    }
+    else if (move.IsCastling()) {
+        const int rank = from & ~7;
+        const bool king_side = move.GetFlag() == Move::Flag::KING_CASTLE;
+        const int rook_from = rank + (king_side ? dimension_x_ - 1 : 0);
+        const int rook_to = (king_side ? to - 1 : to + 1);
+
+        RelocatePiece(rook_from, rook_to);
+    }
+
+    if (move.IsPromotion()) {
+        LiftPiece(from);
+        PlacePiece(MakePiece(colour, move.GetPromotionType()), to);
+    }
+    else {
+        RelocatePiece(from, to);
+    }
+
+    // Moving the king forfeits both castling rights, moving a rook from (or capturing one on) its
+    // corner forfeits the castling right on that side.
+    if (type == PieceBase::PieceType::KING) {
+        castling_rights_ &= (colour == PieceBase::PieceColour::WHITE)
+                                ? ~(WHITE_KING_SIDE | WHITE_QUEEN_SIDE)
+                                : ~(BLACK_KING_SIDE | BLACK_QUEEN_SIDE);
+    }
+    castling_rights_ &= ~(CornerCastlingRight(from) | CornerCastlingRight(to));
+    key_ ^= zobrist::keys.castling[undo.castling_rights] ^ zobrist::keys.castling[castling_rights_];
+
+    // Only keep the en passant square if an enemy pawn can actually capture onto it.
+    if (en_passant_square_ != kNoSquare) {
+        key_ ^= zobrist::keys.en_passant[en_passant_square_ % bitboard::kBoardSize];
     }
-    for (const auto& piece : black_pieces_) {
-        if (piece.GetPosition() == position) {
-            return &piece;
+    en_passant_square_ = kNoSquare;
+    if (move.GetFlag() == Move::Flag::DOUBLE_PAWN_PUSH) {
+        const int skipped = (from + to) / 2;
+        const Bitboard enemy_pawns =
+            GetPieceBitboard(OppositeColour(colour), PieceBase::PieceType::PAWN);
+
+        if ((attacks::PawnAttacks(colour, skipped) & enemy_pawns) != bitboard::kEmpty) {
+            en_passant_square_ = skipped;
+            key_ ^= zobrist::keys.en_passant[skipped % bitboard::kBoardSize];
         }
     }
-    return nullptr;
+
+    if (colour == PieceBase::PieceColour::BLACK) {
+        fullmove_number_++;
+    }
+    side_to_move_ = OppositeColour(colour);
+    key_ ^= zobrist::keys.black_to_move;
+}
+
+void BoardArea::UnmakeMove(const UndoRecord& undo) noexcept
+{
+    const Move move = undo.move;
+    const int from = move.GetFrom();
+    const int to = move.GetTo();
+    const PieceBase::PieceColour colour = OppositeColour(side_to_move_);
+
+    if (move.IsPromotion()) {
+        LiftPiece(to);
+        PlacePiece(MakePiece(colour, PieceBase::PieceType::PAWN), from);
+    }
+    else {
+        RelocatePiece(to, from);
+    }
+
+    if (move.IsCapture()) {
+        const int captured = move.IsEnPassant() ? (from & ~7) | (to & 7) : to;
+
+        PlacePiece(undo.captured, captured);
+    }
+    else if (move.IsCastling()) {
+        const int rank = from & ~7;
+        const bool king_side = move.GetFlag() == Move::Flag::KING_CASTLE;
+        const int rook_from = rank + (king_side ? dimension_x_ - 1 : 0);
+        const int rook_to = (king_side ? to - 1 : to + 1);
+
+        RelocatePiece(rook_to, rook_from);
+    }
+
+    if (colour == PieceBase::PieceColour::BLACK) {
+        fullmove_number_--;
+    }
+    side_to_move_ = colour;
+    castling_rights_ = undo.castling_rights;
+    en_passant_square_ = undo.en_passant_square;
+    halfmove_clock_ = undo.halfmove_clock;
+    key_ = undo.key;
+}
+
+void BoardArea::SetSideToMove(PieceBase::PieceColour colour) noexcept
+{
+    if (colour != side_to_move_) {
+        key_ ^= zobrist::keys.black_to_move;
+    }
+    side_to_move_ = colour;
+}
+
+void BoardArea::SetCastlingRights(std::uint8_t rights) noexcept
+{
+    key_ ^= zobrist::keys.castling[castling_rights_] ^ zobrist::keys.castling[rights];
+    castling_rights_ = rights;
 }
 
-const bool BoardArea::IsWithinBounds(const Position2D& position) const noexcept
+void BoardArea::SetEnPassantSquare(int square) noexcept
+{
+    if (en_passant_square_ != kNoSquare) {
+        key_ ^= zobrist::keys.en_passant[en_passant_square_ % bitboard::kBoardSize];
+    }
+    if (square != kNoSquare) {
+        key_ ^= zobrist::keys.en_passant[square % bitboard::kBoardSize];
+    }
+    en_passant_square_ = square;
+}
+
+const PieceBase* BoardArea::GetPieceAt(const Position2D& position) const noexcept
+{
+    if (!IsWithinBounds(position)) {
+        return nullptr;
+    }
+    RebuildPieceObjects();
+    return piece_objects_[position.ToSquareIndex()];
+}
+
+bool BoardArea::IsWithinBounds(const Position2D& position) const noexcept
 {
     return (position.x >= 0 && position.x < dimension_x_ && position.y >= 0 &&
             position.y < dimension_y_);
 }
+
+bool BoardArea::IsOccupied(const Position2D& position) const noexcept
+{
+    return IsWithinBounds(position) &&
+           bitboard::IsSet(occupied_bitboard_, position.ToSquareIndex());
+}
+
+bool BoardArea::IsOccupiedBy(const Position2D& position,
+                             PieceBase::PieceColour colour) const noexcept
+{
+    return IsWithinBounds(position) &&
+           bitboard::IsSet(GetColourBitboard(colour), position.ToSquareIndex());
+}
+
+void BoardArea::RebuildPieceObjects(void) const noexcept
+{
+    // Most calls find the objects up to date, and needn't take the lock for that.
+    if (!pieces_stale_.load(std::memory_order_acquire)) {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(pieces_mutex_);
+    if (!pieces_stale_.load(std::memory_order_relaxed)) {
+        return;
+    }
+
+    // A move changes a few squares, so only their objects are replaced.
+    for (int square = 0; square < bitboard::kSquareCount; square++) {
+        const Piece piece = squares_[square];
+        if (piece == object_squares_[square]) {
+            continue;
+        }
+
+        if (piece_objects_[square] != nullptr) {
+            auto& pieces = pieces_[static_cast<int>(GetPieceColour(object_squares_[square]))];
+            const PieceBase* old_object = piece_objects_[square];
+            pieces.erase(std::find_if(pieces.begin(), pieces.end(),
+                                      [old_object](const std::unique_ptr<PieceBase>& object) {
+                                          return object.get() == old_object;
+                                      }));
+            piece_objects_[square] = nullptr;
+        }
+
+        object_squares_[square] = piece;
+        if (piece == Piece::NONE) {
+            continue;
+        }
+
+        const PieceBase::PieceColour colour = GetPieceColour(piece);
+        const PieceBase::PieceType type = GetPieceType(piece);
+        const Position2D position = Position2D::FromSquareIndex(square);
+        std::unique_ptr<PieceBase> object = PieceBase::Create(type, colour, position);
+
+        // Pawns only leave their starting rank by moving, and never come back to it.
+        const int start_rank = (colour == PieceBase::PieceColour::WHITE ? 1 : dimension_y_ - 2);
+        if (type == PieceBase::PieceType::PAWN && position.y != start_rank) {
+            object->Move(position);
+        }
+
+        piece_objects_[square] = object.get();
+        pieces_[static_cast<int>(colour)].push_back(std::move(object));
+    }
+
+    pieces_stale_.store(false, std::memory_order_release);
+}
+
+void BoardArea::PlacePiece(Piece piece, int square) noexcept
+{
+    TogglePieceBits(GetPieceColour(piece), GetPieceType(piece), square);
+    squares_[square] = piece;
+    pieces_stale_.store(true, std::memory_order_relaxed);
+}
+
+Piece BoardArea::LiftPiece(int square) noexcept
+{
+    const Piece piece = squares_[square];
+
+    TogglePieceBits(GetPieceColour(piece), GetPieceType(piece), square);
+    squares_[square] = Piece::NONE;
+    pieces_stale_.store(true, std::memory_order_relaxed);
+
+    return piece;
+}
+
+void BoardArea::RelocatePiece(int from, int to) noexcept
+{
+    const Piece piece = squares_[from];
+
+    TogglePieceBits(GetPieceColour(piece), GetPieceType(piece), from);
+    TogglePieceBits(GetPieceColour(piece), GetPieceType(piece), to);
+    squares_[from] = Piece::NONE;
+    squares_[to] = piece;
+    pieces_stale_.store(true, std::memory_order_relaxed);
+}
+
+std::uint8_t BoardArea::CornerCastlingRight(int square) const noexcept
+{
+    const int top_rank = (dimension_y_ - 1) * bitboard::kBoardSize;
+
+    if (square == 0) {
+        return WHITE_QUEEN_SIDE;
+    }
+    if (square == dimension_x_ - 1) {
+        return WHITE_KING_SIDE;
+    }
+    if (square == top_rank) {
+        return BLACK_QUEEN_SIDE;
+    }
+    if (square == top_rank + dimension_x_ - 1) {
+        return BLACK_KING_SIDE;
+    }
+    return NO_CASTLING;
+}
+
+void BoardArea::TogglePieceBits(PieceBase::PieceColour colour, PieceBase::PieceType type,
+                                int square) noexcept
+{
+    const Bitboard bit = bitboard::SquareBit(square);
+
+    piece_bitboards_[static_cast<int>(colour)][static_cast<int>(type)] ^= bit;
+    colour_bitboards_[static_cast<int>(colour)] ^= bit;
+    occupied_bitboard_ ^= bit;
+    key_ ^= zobrist::PieceKey(colour, type, square);
+    if (type == PieceBase::PieceType::PAWN) {
+        pawn_key_ ^= zobrist::PieceKey(colour, type, square);
+    }
+
+    // The piece was added if its bit is set now, and removed otherwise.
+    const int sign =
+        (piece_bitboards_[static_cast<int>(colour)][static_cast<int>(type)] & bit) ? 1 : -1;
+    middlegame_score_ += sign * psqt::MiddlegameScore(colour, type, square);
+    endgame_score_ += sign * psqt::EndgameScore(colour, type, square);
+    phase_ += sign * psqt::kPhaseWeights[static_cast<int>(type)];
+}
@@ -10,45 +10,124 @@
 
 #pragma once
 
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
 #include <vector>
 
 #include "area_base.hpp"
+#include "bitboard.hpp"
+#include "move.hpp"
 #include "piece_base.hpp"
 #include "pos2d.hpp"
+#include "zobrist.hpp"
 
 namespace raychess
 {
     class BoardArea : public AreaBase
     {
     public:
+        static constexpr int kColourCount = 2;     ///< Number of piece colours.
+        static constexpr int kPieceTypeCount = 6;  ///< Number of piece types.
+        static constexpr int kNoSquare = -1;       ///< Square index meaning "no square".
+
+        /**
+         * @brief       Flags representing the castling rights, combined into a bit mask.
+         */
+        enum CastlingRight : std::uint8_t
+        {
+            NO_CASTLING = 0,
+            WHITE_KING_SIDE = 1,
+            WHITE_QUEEN_SIDE = 2,
+            BLACK_KING_SIDE = 4,
+            BLACK_QUEEN_SIDE = 8,
+            ALL_CASTLING = 15
+        };
+
+        /**
+         * @brief       Everything MakeMove() changes that can't be derived from the move itself.
+         *
+         * Filled in by MakeMove() and consumed by UnmakeMove() to restore the board exactly.
+         */
+        struct UndoRecord
+        {
+            std::uint64_t key;              ///< Zobrist key before the move.
+            Move move;                      ///< The move that was made.
+            std::uint8_t castling_rights;   ///< Castling rights before the move.
+            std::int8_t en_passant_square;  ///< En passant square before the move.
+            Piece captured;                 ///< The captured piece, or Piece::NONE.
+            int halfmove_clock;             ///< Halfmove clock before the move.
+        };
+
         /**
-         * @brief       Using the base class constructor.
+         * @brief       Constructor.
+         *
+         * The board is backed by bitboards, so neither of the dimensions may exceed 8.
          *
          * @see         AreaBase::AreaBase(int dimension_x, int dimension_y)
+         *
+         * @param[in]   dimension_x  The x dimension of the board.
+         * @param[in]   dimension_y  The y dimension of the board.
          */
-        using AreaBase::AreaBase;
+        BoardArea(int dimension_x, int dimension_y) noexcept;
+
+        /**
+         * @brief       Copy constructor. Makes a deep copy of the board.
+         *
+         * Copies are independent of each other, so each one can be used by a different thread.
+         * Only the position is copied, the piece objects are rebuilt by the copy when asked for.
+         *
+         * @param[in]   other  The board to copy.
+         */
+        BoardArea(const BoardArea& other) noexcept;
+
+        /**
+         * @brief       Copy assignment is not supported, copy construct a new board instead.
+         */
+        BoardArea& operator=(const BoardArea&) = delete;
 
         /**
          * @brief       Motehod to get the pieces in the board area of the given colour.
          *
+         * The board keeps its pieces as Piece values, the piece objects are a view of them for
+         * code that wants objects, such as the user interface. They are brought up to date on
+         * the first call after the position changed, replacing only the objects of the squares
+         * whose piece changed, which invalidates those objects.
+         *
+         * The update is guarded, so several threads may read the same const board at once. The
+         * board mustn't be changed while another thread reads its piece objects, though.
+         *
          * @see         AreaBase::GetPiecesByColour(PieceBase::PieceColour which_colour)
          *
          * @param[in]   which_colour  The colour of the pieces to get.
          *
          * @return      A const reference to the vector of pieces in the area.
          */
-        const std::vector<PieceBase>& GetPiecesByColour(
+        const std::vector<std::unique_ptr<PieceBase>>& GetPiecesByColour(
             PieceBase::PieceColour which_colour) const noexcept override;
 
         /**
          * @brief       Method to add a piece to the board area.
          *
+         * The piece's position must be within bounds and not occupied by another piece.
+         *
          * @see         AreaBase::AddPiece(PieceBase piece)
          *
          * @param[in]   piece  The piece to add to the area.
          */
         void AddPiece(PieceBase& piece) noexcept override;
 
+        /**
+         * @brief       Method to add a piece to the board area.
+         *
+         * The square must be within bounds and not occupied by another piece.
+         *
+         * @param[in]   piece   The piece to add to the area.
+         * @param[in]   square  The square index to put the piece on.
+         */
+        void AddPiece(Piece piece, int square) noexcept;
+
         /**
          * @brief       Method to remove all pieces from the area.
          *
@@ -64,9 +143,57 @@ namespace raychess
          */
         void RemovePiece(const Position2D& position, PieceBase::PieceColour colour) noexcept;
 
+        /**
+         * @brief       Method to move a piece from one position to another.
+         *
+         * A piece of the opposite colour at the target position is removed from the board. The
+         * target position must not be occupied by a piece of the moving piece's colour.
+         *
+         * @param[in]   from  The position of the piece to move.
+         * @param[in]   to    The position to move the piece to.
+         */
+        void MovePiece(const Position2D& from, const Position2D& to) noexcept;
+
+        /**
+         * @brief       Method to apply a move to the board for good.
+         *
+         * Same as MakeMove(), for moves which won't be taken back.
+         *
+         * @param[in]   move  The move to apply, as produced by the pieces' move generators.
+         */
+        void ApplyMove(Move move) noexcept;
+
+        /**
+         * @brief       Method to make a move on the board, so that it can be taken back later.
+         *
+         * Besides moving the piece itself, this takes care of everything else the move's flags
+         * call for: capturing, moving the rook when castling, removing the pawn captured en
+         * passant and replacing a promoted pawn. The side to move, castling rights, en passant
+         * square and move counters are updated as well.
+         *
+         * Only the Piece values, bitboards, keys and scores are updated, so making a move
+         * allocates nothing and calls no virtual methods.
+         *
+         * @param[in]   move  The move to make, as produced by the pieces' move generators.
+         * @param[out]  undo  The record to store the information needed to unmake the move in.
+         */
+        void MakeMove(Move move, UndoRecord& undo) noexcept;
+
+        /**
+         * @brief       Method to take back the last move made by MakeMove().
+         *
+         * Moves have to be unmade in the reverse order they were made in.
+         *
+         * @param[in]   undo  The record MakeMove() filled in.
+         */
+        void UnmakeMove(const UndoRecord& undo) noexcept;
+
         /**
          * @brief       Method to get a piece (if any) at the given position.
          *
+         * The piece objects may have to be brought up to date first, see GetPiecesByColour().
+         * GetPiece() is the cheaper lookup.
+         *
          * @param[in]   position  The position to get the piece at.
          *
          * @return      A pointer to the piece at the given position, or nullptr if there is no
@@ -74,6 +201,17 @@ namespace raychess
          */
         const PieceBase* GetPieceAt(const Position2D& position) const noexcept;
 
+        /**
+         * @brief       Gets the piece on a square.
+         *
+         * The lookup is a single index into the board's square table.
+         *
+         * @param[in]   square  The square index.
+         *
+         * @return      The piece on the square, or Piece::NONE if the square is empty.
+         */
+        Piece GetPiece(int square) const noexcept { return squares_[square]; }
+
         /**
          * @brief       Checks whether a piece is within the board's game area.
          *
@@ -81,10 +219,270 @@ namespace raychess
          *
          * @return      True if the position is within the board's game area, false otherwise.
          */
-        const bool IsWithinBounds(const Position2D& position) const noexcept;
+        bool IsWithinBounds(const Position2D& position) const noexcept;
+
+        /**
+         * @brief       Checks whether there is a piece (of any colour) at the given position.
+         *
+         * @param[in]   position  The position to check.
+         *
+         * @return      True if the position is within bounds and occupied, false otherwise.
+         */
+        bool IsOccupied(const Position2D& position) const noexcept;
+
+        /**
+         * @brief       Checks whether there is a piece of the given colour at the given position.
+         *
+         * @param[in]   position  The position to check.
+         * @param[in]   colour    The colour of the piece.
+         *
+         * @return      True if the position is within bounds and occupied by a piece of the given
+         * colour, false otherwise.
+         */
+        bool IsOccupiedBy(const Position2D& position, PieceBase::PieceColour colour) const noexcept;
+
+        /**
+         * @brief       Side to move getter.
+         *
+         * @return      The colour of the side to move.
+         */
+        PieceBase::PieceColour GetSideToMove(void) const noexcept { return side_to_move_; }
+
+        /**
+         * @brief       Side to move setter.
+         *
+         * @param[in]   colour  The colour of the side to move.
+         */
+        void SetSideToMove(PieceBase::PieceColour colour) noexcept;
+
+        /**
+         * @brief       Castling rights getter.
+         *
+         * @return      The castling rights, a combination of the CastlingRight flags.
+         */
+        std::uint8_t GetCastlingRights(void) const noexcept { return castling_rights_; }
+
+        /**
+         * @brief       Castling rights setter.
+         *
+         * @param[in]   rights  The castling rights, a combination of the CastlingRight flags.
+         */
+        void SetCastlingRights(std::uint8_t rights) noexcept;
+
+        /**
+         * @brief       En passant square getter.
+         *
+         * The en passant square is the square a pawn skipped over with a double push in the last
+         * move, as long as an enemy pawn is in a position to capture it.
+         *
+         * @return      The en passant square index, or kNoSquare if there is none.
+         */
+        int GetEnPassantSquare(void) const noexcept { return en_passant_square_; }
+
+        /**
+         * @brief       En passant square setter.
+         *
+         * @param[in]   square  The en passant square index, or kNoSquare if there is none.
+         */
+        void SetEnPassantSquare(int square) noexcept;
+
+        /**
+         * @brief       Halfmove clock getter.
+         *
+         * @return      The number of halfmoves since the last capture or pawn move.
+         */
+        int GetHalfmoveClock(void) const noexcept { return halfmove_clock_; }
+
+        /**
+         * @brief       Halfmove clock setter.
+         *
+         * @param[in]   halfmove_clock  The number of halfmoves since the last capture or pawn move.
+         */
+        void SetHalfmoveClock(int halfmove_clock) noexcept { halfmove_clock_ = halfmove_clock; }
+
+        /**
+         * @brief       Fullmove number getter.
+         *
+         * @return      The number of the current full move, starting at 1.
+         */
+        int GetFullmoveNumber(void) const noexcept { return fullmove_number_; }
+
+        /**
+         * @brief       Fullmove number setter.
+         *
+         * @param[in]   fullmove_number  The number of the current full move, starting at 1.
+         */
+        void SetFullmoveNumber(int fullmove_number) noexcept { fullmove_number_ = fullmove_number; }
+
+        /**
+         * @brief       Zobrist key getter.
+         *
+         * The key is kept up to date as pieces are added, removed and moved and as the rest of the
+         * position changes, so getting it costs nothing.
+         *
+         * @see         zobrist::ComputeKey()
+         *
+         * @return      The Zobrist key of the position.
+         */
+        std::uint64_t GetKey(void) const noexcept { return key_; }
+
+        /**
+         * @brief       Pawn key getter.
+         *
+         * @see         zobrist::ComputePawnKey()
+         *
+         * @return      The Zobrist key of the pawns of the position.
+         */
+        std::uint64_t GetPawnKey(void) const noexcept { return pawn_key_; }
+
+        /**
+         * @brief       Middlegame score getter.
+         *
+         * The scores and the phase are kept up to date as pieces are added, removed and moved, so
+         * evaluating the material and the placement of the pieces costs nothing.
+         *
+         * @see         psqt::ComputeScores()
+         *
+         * @return      The sum of the middlegame piece-square scores, positive if white is better.
+         */
+        int GetMiddlegameScore(void) const noexcept { return middlegame_score_; }
+
+        /**
+         * @brief       Endgame score getter.
+         *
+         * @see         GetMiddlegameScore()
+         *
+         * @return      The sum of the endgame piece-square scores, positive if white is better.
+         */
+        int GetEndgameScore(void) const noexcept { return endgame_score_; }
+
+        /**
+         * @brief       Game phase getter.
+         *
+         * @return      The phase weights of all pieces summed, psqt::kMaxPhase in the starting
+         * position, falling towards 0 as pieces are traded (and above the maximum after
+         * promotions).
+         */
+        int GetPhase(void) const noexcept { return phase_; }
+
+        /**
+         * @brief       Gets the squares occupied by pieces of the given colour and type.
+         *
+         * @param[in]   colour  The colour of the pieces.
+         * @param[in]   type    The type of the pieces.
+         *
+         * @return      A bitboard of the occupied squares.
+         */
+        Bitboard GetPieceBitboard(PieceBase::PieceColour colour,
+                                  PieceBase::PieceType type) const noexcept
+        {
+            return piece_bitboards_[static_cast<int>(colour)][static_cast<int>(type)];
+        }
+
+        /**
+         * @brief       Gets the squares occupied by pieces of the given colour.
+         *
+         * @param[in]   colour  The colour of the pieces.
+         *
+         * @return      A bitboard of the occupied squares.
+         */
+        Bitboard GetColourBitboard(PieceBase::PieceColour colour) const noexcept
+        {
+            return colour_bitboards_[static_cast<int>(colour)];
+        }
+
+        /**
+         * @brief       Gets the squares occupied by pieces of any colour.
+         *
+         * @return      A bitboard of the occupied squares.
+         */
+        Bitboard GetOccupiedBitboard(void) const noexcept { return occupied_bitboard_; }
+
+        /**
+         * @brief       Gets the squares that lie within the board's game area.
+         *
+         * @return      A bitboard of the squares within bounds.
+         */
+        Bitboard GetBoardMask(void) const noexcept { return board_mask_; }
 
     protected:
-        std::vector<PieceBase> white_pieces_;  ///< Collection of white pieces in the area.
-        std::vector<PieceBase> black_pieces_;  ///< Collection of black pieces in the area.
+        /// Piece objects by colour, brought up to date from the square table when stale.
+        mutable std::vector<std::unique_ptr<PieceBase>> pieces_[kColourCount];
+        mutable PieceBase* piece_objects_[bitboard::kSquareCount];  ///< Object on each square.
+        mutable Piece object_squares_[bitboard::kSquareCount];      ///< Piece of each object.
+        mutable std::atomic<bool> pieces_stale_;  ///< Whether the objects are out of date.
+        mutable std::mutex pieces_mutex_;         ///< Guards the update of the objects.
+
+        Bitboard piece_bitboards_[kColourCount][kPieceTypeCount];  ///< Squares by colour and type.
+        Bitboard colour_bitboards_[kColourCount];                  ///< Squares by colour.
+        Bitboard occupied_bitboard_;                               ///< Squares of all pieces.
+        Bitboard board_mask_;                                      ///< Squares within bounds.
+
+        Piece squares_[bitboard::kSquareCount];  ///< Piece on each square, or Piece::NONE.
+
+        PieceBase::PieceColour side_to_move_;  ///< The colour of the side to move.
+        std::uint8_t castling_rights_;         ///< Combination of the CastlingRight flags.
+        int en_passant_square_;                ///< En passant square index, or kNoSquare.
+        int halfmove_clock_;                   ///< Halfmoves since the last capture or pawn move.
+        int fullmove_number_;                  ///< Number of the current full move.
+        std::uint64_t key_;                    ///< Zobrist key of the position.
+        std::uint64_t pawn_key_;               ///< Zobrist key of the pawns.
+        int middlegame_score_;                 ///< Sum of the middlegame piece-square scores.
+        int endgame_score_;                    ///< Sum of the endgame piece-square scores.
+        int phase_;                            ///< Sum of the phase weights of the pieces.
+
+    private:
+        /**
+         * @brief       Brings the piece objects up to date with the square table, if they are
+         * stale.
+         */
+        void RebuildPieceObjects(void) const noexcept;
+
+        /**
+         * @brief       Puts a piece on an empty square.
+         *
+         * @param[in]   piece   The piece to put on the board.
+         * @param[in]   square  The square index.
+         */
+        void PlacePiece(Piece piece, int square) noexcept;
+
+        /**
+         * @brief       Takes a piece off the board.
+         *
+         * @param[in]   square  The square index of the piece.
+         *
+         * @return      The piece taken off the board.
+         */
+        Piece LiftPiece(int square) noexcept;
+
+        /**
+         * @brief       Moves a piece between two squares in the bitboards and the square table.
+         *
+         * The target square must be empty.
+         *
+         * @param[in]   from  The square index the piece moves from.
+         * @param[in]   to    The square index the piece moves to.
+         */
+        void RelocatePiece(int from, int to) noexcept;
+
+        /**
+         * @brief       Gets the castling right lost when a piece moves from or to a corner square.
+         *
+         * @param[in]   square  The square index.
+         *
+         * @return      The castling right of the rook starting on the square, or NO_CASTLING if the
+         * square is not a corner of the board.
+         */
+        std::uint8_t CornerCastlingRight(int square) const noexcept;
+
+        /**
+         * @brief       Sets or clears a piece's square in all bitboards, the keys and the scores.
+         *
+         * @param[in]   colour  The colour of the piece.
+         * @param[in]   type    The type of the piece.
+         * @param[in]   square  The square index of the piece.
+         */
+        void TogglePieceBits(PieceBase::PieceColour colour, PieceBase::PieceType type,
+                             int square) noexcept;
     };
 }  // namespace raychess
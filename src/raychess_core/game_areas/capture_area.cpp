@@ -12,19 +12,20 @@
 
 using namespace raychess;
 
-const std::vector<PieceBase>& CaptureArea::GetPiecesByColour(
-    PieceBase::PieceColour which_colour) const
+const std::vector<std::unique_ptr<PieceBase>>& CaptureArea::GetPiecesByColour(
+    PieceBase::PieceColour which_colour) const noexcept
 {
     return pieces_;
 }
 
-void CaptureArea::AddPiece(PieceBase& piece) noexcept { pieces_.push_back(piece); }
+void CaptureArea::AddPiece(PieceBase& piece) noexcept { pieces_.push_back(piece.Clone()); }
 
 void CaptureArea::ClearArea(void) noexcept { pieces_.clear(); }
 
 void CaptureArea::SortPieces(void) noexcept
 {
-    std::sort(pieces_.begin(), pieces_.end(), [](const PieceBase& lhs, const PieceBase& rhs) {
-        return lhs.GetPointEvaulation() < rhs.GetPointEvaulation();
-    });
+    std::sort(pieces_.begin(), pieces_.end(),
+              [](const std::unique_ptr<PieceBase>& lhs, const std::unique_ptr<PieceBase>& rhs) {
+                  return lhs->GetPointEvaulation() < rhs->GetPointEvaulation();
+              });
 }
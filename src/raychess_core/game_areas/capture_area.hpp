@@ -11,6 +11,7 @@
 #pragma once
 
 #include <algorithm>
+#include <memory>
 #include <vector>
 
 #include "area_base.hpp"
@@ -39,8 +40,8 @@ namespace raychess
          *
          * @return      A const reference to the vector of pieces in the area.
          */
-        const std::vector<PieceBase>& GetPiecesByColour(
-            PieceBase::PieceColour which_colour) const override;
+        const std::vector<std::unique_ptr<PieceBase>>& GetPiecesByColour(
+            PieceBase::PieceColour which_colour) const noexcept override;
 
         /**
          * @brief       Method to add a piece to the board area.
@@ -63,9 +64,9 @@ namespace raychess
          *
          * Sorts the pieces in the area according to their point evaluation.
          */
-        void SortPieces(void) noexcept { return; }
+        void SortPieces(void) noexcept;
 
     protected:
-        std::vector<PieceBase> pieces_;  ///< Collection of captured pieces.
+        std::vector<std::unique_ptr<PieceBase>> pieces_;  ///< Collection of captured pieces.
     };
 }  // namespace raychess
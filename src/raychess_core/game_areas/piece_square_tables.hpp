@@ -0,0 +1,89 @@
+/**
+ * @file    piece_square_tables.hpp
+ *
+ * @brief   Material and piece-square scores of the pieces.
+ *
+ * @section DESCRIPTION
+ *
+ * A piece-square table gives every piece a score for every square it may stand on, its material
+ * value included. The score of a position is then just the sum of its pieces' scores, which can
+ * be kept up to date as pieces move by subtracting the score of the square a piece leaves and
+ * adding the score of the square it arrives at. BoardArea keeps the scores of its position up to
+ * date this way.
+ *
+ * Pieces are worth different amounts in the middlegame and in the endgame (the king hides in the
+ * middlegame, but becomes an active piece in the endgame), so there are two scores, which the
+ * evaluation blends by the game phase. The phase is measured by the material still on the board.
+ */
+
+#pragma once
+
+#include "bitboard.hpp"
+#include "piece_types.hpp"
+
+namespace raychess
+{
+    class BoardArea;
+
+    namespace psqt
+    {
+        constexpr int kMaxPhase = 24;  ///< Phase of the starting position, pure middlegame.
+
+        /**
+         * @brief   How much each piece type counts towards the game phase, by PieceType.
+         */
+        constexpr int kPhaseWeights[6] = {0, 1, 1, 2, 4, 0};
+
+        /**
+         * @brief   The scores of all pieces on all squares, white's pieces positive.
+         */
+        struct ScoreTable
+        {
+            int middlegame[2][6][bitboard::kSquareCount];  ///< By colour, type and square.
+            int endgame[2][6][bitboard::kSquareCount];     ///< By colour, type and square.
+        };
+
+        extern const ScoreTable scores;  ///< The scores, generated at compile time.
+
+        /**
+         * @brief       Gets the middlegame score of a piece on a square.
+         *
+         * @param[in]   colour  The colour of the piece.
+         * @param[in]   type    The type of the piece.
+         * @param[in]   square  The square index.
+         *
+         * @return      The score, positive for white's pieces and negative for black's.
+         */
+        inline int MiddlegameScore(PieceColour colour, PieceType type, int square) noexcept
+        {
+            return scores.middlegame[static_cast<int>(colour)][static_cast<int>(type)][square];
+        }
+
+        /**
+         * @brief       Gets the endgame score of a piece on a square.
+         *
+         * @param[in]   colour  The colour of the piece.
+         * @param[in]   type    The type of the piece.
+         * @param[in]   square  The square index.
+         *
+         * @return      The score, positive for white's pieces and negative for black's.
+         */
+        inline int EndgameScore(PieceColour colour, PieceType type, int square) noexcept
+        {
+            return scores.endgame[static_cast<int>(colour)][static_cast<int>(type)][square];
+        }
+
+        /**
+         * @brief       Computes the scores and the phase of a position from scratch.
+         *
+         * Meant for checking the scores BoardArea keeps up to date, use its getters otherwise.
+         *
+         * @param[in]   board       The board holding the position.
+         * @param[out]  middlegame  The middlegame score.
+         * @param[out]  endgame     The endgame score.
+         * @param[out]  phase       The game phase.
+         */
+        void ComputeScores(const BoardArea& board, int& middlegame, int& endgame,
+                           int& phase) noexcept;
+    }  // namespace psqt
+}  // namespace raychess
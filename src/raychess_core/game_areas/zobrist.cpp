@@ -0,0 +1,111 @@
+/**
+ * @file    zobrist.cpp
+ *
+ * @brief   Zobrist hashing of positions.
+ *
+ * @section DESCRIPTION
+ *
+ * A Zobrist key identifies a position by a single 64-bit number, all its features' keys XORed
+ * together.
+ */
+
+#include "zobrist.hpp"
+
+#include <cstddef>
+
+#include "board_area.hpp"
+
+using namespace raychess;
+
+namespace
+{
+    /**
+     * @brief       Generates the keys using a xorshift64* generator.
+     *
+     * The generator is seeded with a constant, so the keys are the same in every build, which keeps
+     * anything storing keys (such as opening books or test expectations) valid.
+     *
+     * @return      The keys.
+     */
+    constexpr zobrist::KeyTable GenerateKeys(void) noexcept
+    {
+        zobrist::KeyTable table{};
+        std::uint64_t state = 0x2545f4914f6cdd1dULL;
+
+        // The table is nothing but keys, so it can be filled as one flat array of them.
+        constexpr std::size_t count = sizeof(zobrist::KeyTable) / sizeof(std::uint64_t);
+        for (std::size_t i = 0; i < count; i++) {
+            state ^= state >> 12;
+            state ^= state << 25;
+            state ^= state >> 27;
+
+            const std::uint64_t key = state * 2685821657736338717ULL;
+            const std::size_t piece_count = sizeof(table.pieces) / sizeof(std::uint64_t);
+
+            if (i < piece_count) {
+                table.pieces[i / (6 * bitboard::kSquareCount)][i / bitboard::kSquareCount % 6]
+                            [i % bitboard::kSquareCount] = key;
+            }
+            else if (i == piece_count) {
+                table.black_to_move = key;
+            }
+            else if (i < piece_count + 1 + 16) {
+                table.castling[i - piece_count - 1] = key;
+            }
+            else {
+                table.en_passant[i - piece_count - 1 - 16] = key;
+            }
+        }
+
+        // No castling rights are the usual case, leaving them out of the key saves a XOR.
+        table.castling[BoardArea::NO_CASTLING] = 0;
+
+        return table;
+    }
+}  // namespace
+
+// Defined as extern constexpr, so that the keys are computed by the compiler, yet exist only once
+// in the whole program.
+extern constexpr zobrist::KeyTable zobrist::keys = GenerateKeys();
+
+std::uint64_t zobrist::ComputeKey(const BoardArea& board) noexcept
+{
+    std::uint64_t key = 0;
+
+    for (int colour = 0; colour < BoardArea::kColourCount; colour++) {
+        for (int type = 0; type < BoardArea::kPieceTypeCount; type++) {
+            Bitboard pieces = board.GetPieceBitboard(static_cast<PieceColour>(colour),
+                                                     static_cast<PieceType>(type));
+
+            while (pieces != bitboard::kEmpty) {
+                key ^= keys.pieces[colour][type][bitboard::PopLsb(pieces)];
+            }
+        }
+    }
+
+    if (board.GetSideToMove() == PieceColour::BLACK) {
+        key ^= keys.black_to_move;
+    }
+    key ^= keys.castling[board.GetCastlingRights()];
+    if (board.GetEnPassantSquare() != BoardArea::kNoSquare) {
+        key ^= keys.en_passant[board.GetEnPassantSquare() % bitboard::kBoardSize];
+    }
+
+    return key;
+}
+
+std::uint64_t zobrist::ComputePawnKey(const BoardArea& board) noexcept
+{
+    std::uint64_t key = 0;
+
+    for (int colour = 0; colour < BoardArea::kColourCount; colour++) {
+        Bitboard pawns =
+            board.GetPieceBitboard(static_cast<PieceColour>(colour), PieceType::PAWN);
+
+        while (pawns != bitboard::kEmpty) {
+            key ^= keys.pieces[colour][static_cast<int>(PieceType::PAWN)][bitboard::PopLsb(pawns)];
+        }
+    }
+
+    return key;
+}
@@ -0,0 +1,81 @@
+/**
+ * @file    zobrist.hpp
+ *
+ * @brief   Zobrist hashing of positions.
+ *
+ * @section DESCRIPTION
+ *
+ * A Zobrist key identifies a position by a single 64-bit number: every feature of the position (a
+ * piece on a square, the side to move, the castling rights and the en passant file) has its own
+ * random key, and the key of the position is all its features' keys XORed together. Two different
+ * positions getting the same key is unlikely enough to be ignored.
+ *
+ * XOR being its own inverse, the key can be updated as the position changes by XORing in (or out)
+ * only the features that changed. BoardArea keeps the key of its position up to date this way.
+ */
+
+#pragma once
+
+#include <cstdint>
+
+#include "bitboard.hpp"
+#include "piece_types.hpp"
+
+namespace raychess
+{
+    class BoardArea;
+
+    namespace zobrist
+    {
+        /**
+         * @brief   The keys of all features of a position.
+         */
+        struct KeyTable
+        {
+            std::uint64_t pieces[2][6][bitboard::kSquareCount];  ///< By colour, type and square.
+            std::uint64_t black_to_move;                         ///< Black being the side to move.
+            std::uint64_t castling[16];                          ///< By castling rights.
+            std::uint64_t en_passant[bitboard::kBoardSize];      ///< By en passant file.
+        };
+
+        extern const KeyTable keys;  ///< The keys, generated at compile time.
+
+        /**
+         * @brief       Gets the key of a piece on a square.
+         *
+         * @param[in]   colour  The colour of the piece.
+         * @param[in]   type    The type of the piece.
+         * @param[in]   square  The square index.
+         *
+         * @return      The key of the piece on the square.
+         */
+        inline std::uint64_t PieceKey(PieceColour colour, PieceType type, int square) noexcept
+        {
+            return keys.pieces[static_cast<int>(colour)][static_cast<int>(type)][square];
+        }
+
+        /**
+         * @brief       Computes the key of a position from scratch.
+         *
+         * Meant for checking the key BoardArea keeps up to date, use BoardArea::GetKey() otherwise.
+         *
+         * @param[in]   board  The board holding the position.
+         *
+         * @return      The key of the position.
+         */
+        std::uint64_t ComputeKey(const BoardArea& board) noexcept;
+
+        /**
+         * @brief       Computes the pawn key of a position from scratch.
+         *
+         * The pawn key is the key of the pawns alone, so all positions with the same pawn
+         * structure share it. Meant for checking the pawn key BoardArea keeps up to date, use
+         * BoardArea::GetPawnKey() otherwise.
+         *
+         * @param[in]   board  The board holding the position.
+         *
+         * @return      The pawn key of the position.
+         */
+        std::uint64_t ComputePawnKey(const BoardArea& board) noexcept;
+    }  // namespace zobrist
+}  // namespace raychess
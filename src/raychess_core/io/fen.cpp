@@ -0,0 +1,370 @@
+/**
+ * @file    fen.cpp
+ *
+ * @brief   Reading and writing positions in the Forsyth-Edwards Notation.
+ *
+ * @section DESCRIPTION
+ *
+ * FEN describes a whole position in a single line of text: the piece placement, the side to
+ * move, the castling rights, the en passant square and the two move counters.
+ *
+ * The fields are read in place, as pointers into the string, rather than copied out of a stream.
+ */
+
+#include "fen.hpp"
+
+#include <cstring>
+
+#include "position_setup.hpp"
+
+using namespace raychess;
+
+namespace
+{
+    constexpr const char* kPieceLetters = "pnbrqk";  ///< Letters of the pieces, by PieceType.
+    constexpr int kMaxCounterDigits = 9;             ///< Longest move counter, so it fits an int.
+
+    /**
+     * @brief   A field of a FEN string, pointing into the string.
+     */
+    struct Field
+    {
+        const char* begin;  ///< The first character of the field.
+        const char* end;    ///< One past the last character of the field.
+
+        /**
+         * @brief       Compares the field to a string.
+         *
+         * @param[in]   text  The null terminated string to compare to.
+         *
+         * @return      True if the field holds exactly the string, false otherwise.
+         */
+        bool operator==(const char* text) const noexcept
+        {
+            const std::size_t length = std::strlen(text);
+            return static_cast<std::size_t>(end - begin) == length &&
+                   std::memcmp(begin, text, length) == 0;
+        }
+    };
+
+    /**
+     * @brief       Checks whether a character separates the fields of a FEN string.
+     *
+     * @param[in]   c  The character.
+     *
+     * @return      True if the character is whitespace, false otherwise.
+     */
+    bool IsSeparator(char c) noexcept
+    {
+        return c == ' ' || c == '\t' || c == '\r' || c == '\n';
+    }
+
+    /**
+     * @brief       Reads the next field of a FEN string.
+     *
+     * @param[in,out]   cursor  The position in the string, moved past the field.
+     * @param[in]       end     The end of the string.
+     * @param[out]      field   The field read.
+     *
+     * @return      True if there was another field, false otherwise.
+     */
+    bool NextField(const char*& cursor, const char* end, Field& field) noexcept
+    {
+        while (cursor != end && IsSeparator(*cursor)) {
+            cursor++;
+        }
+        if (cursor == end) {
+            return false;
+        }
+
+        field.begin = cursor;
+        while (cursor != end && !IsSeparator(*cursor)) {
+            cursor++;
+        }
+        field.end = cursor;
+        return true;
+    }
+
+    /**
+     * @brief       Places the pieces of the placement field of a FEN string.
+     *
+     * @param[out]  board      The board to place the pieces on.
+     * @param[in]   placement  The placement field, ranks from the eighth to the first.
+     *
+     * @return      True if the field was read successfully, false otherwise.
+     */
+    bool LoadPlacement(BoardArea& board, const Field& placement) noexcept
+    {
+        int x = 0;
+        int y = bitboard::kBoardSize - 1;
+
+        for (const char* c = placement.begin; c != placement.end; c++) {
+            if (*c == '/') {
+                if (x != bitboard::kBoardSize || y == 0) {
+                    return false;
+                }
+                x = 0;
+                y--;
+            }
+            else if (*c >= '1' && *c <= '8') {
+                x += *c - '0';
+            }
+            else {
+                const bool white = (*c >= 'A' && *c <= 'Z');
+                const char lower = white ? static_cast<char>(*c - 'A' + 'a') : *c;
+                // strchr() also finds the terminating null character, which is no piece.
+                const char* letter = lower != 0 ? std::strchr(kPieceLetters, lower) : nullptr;
+
+                if (letter == nullptr || x >= bitboard::kBoardSize) {
+                    return false;
+                }
+
+                const auto type = static_cast<PieceType>(letter - kPieceLetters);
+                const auto colour = (white ? PieceColour::WHITE : PieceColour::BLACK);
+                board.AddPiece(MakePiece(colour, type), Position2D(x, y).ToSquareIndex());
+                x++;
+            }
+
+            if (x > bitboard::kBoardSize) {
+                return false;
+            }
+        }
+
+        return x == bitboard::kBoardSize && y == 0;
+    }
+
+    /**
+     * @brief       Reads the castling field of a FEN string.
+     *
+     * @param[in]   castling  The castling field, "-" or any of "KQkq".
+     * @param[out]  rights    The castling rights read.
+     *
+     * @return      True if the field was read successfully, false otherwise.
+     */
+    bool LoadCastlingRights(const Field& castling, std::uint8_t& rights) noexcept
+    {
+        rights = BoardArea::NO_CASTLING;
+        if (castling == "-") {
+            return true;
+        }
+
+        for (const char* c = castling.begin; c != castling.end; c++) {
+            switch (*c) {
+                case 'K':
+                    rights |= BoardArea::WHITE_KING_SIDE;
+                    break;
+                case 'Q':
+                    rights |= BoardArea::WHITE_QUEEN_SIDE;
+                    break;
+                case 'k':
+                    rights |= BoardArea::BLACK_KING_SIDE;
+                    break;
+                case 'q':
+                    rights |= BoardArea::BLACK_QUEEN_SIDE;
+                    break;
+                default:
+                    return false;
+            }
+        }
+
+        return true;
+    }
+
+    /**
+     * @brief       Reads the en passant field of a FEN string.
+     *
+     * @param[in]   en_passant  The en passant field, "-" or a square.
+     * @param[out]  square      The en passant square, or BoardArea::kNoSquare.
+     *
+     * @return      True if the field was read successfully, false otherwise.
+     */
+    bool LoadEnPassantSquare(const Field& en_passant, int& square) noexcept
+    {
+        square = BoardArea::kNoSquare;
+        if (en_passant == "-") {
+            return true;
+        }
+
+        if (en_passant.end - en_passant.begin != 2 || en_passant.begin[0] < 'a' ||
+            en_passant.begin[0] > 'h' || en_passant.begin[1] < '1' || en_passant.begin[1] > '8') {
+            return false;
+        }
+
+        square = Position2D(en_passant.begin[0] - 'a', en_passant.begin[1] - '1').ToSquareIndex();
+        return true;
+    }
+
+    /**
+     * @brief       Reads a move counter field of a FEN string.
+     *
+     * @param[in]   counter  The field.
+     * @param[out]  value    The counter read.
+     *
+     * @return      True if the field is a non-negative number, false otherwise.
+     */
+    bool LoadCounter(const Field& counter, int& value) noexcept
+    {
+        if (counter.begin == counter.end || counter.end - counter.begin > kMaxCounterDigits) {
+            return false;
+        }
+
+        value = 0;
+        for (const char* c = counter.begin; c != counter.end; c++) {
+            if (*c < '0' || *c > '9') {
+                return false;
+            }
+            value = value * 10 + (*c - '0');
+        }
+
+        return true;
+    }
+
+    /**
+     * @brief       Writes a non-negative number.
+     *
+     * @param[in,out]   out    The position to write at, moved past the number.
+     * @param[in]       value  The number.
+     */
+    void SaveNumber(char*& out, int value) noexcept
+    {
+        char digits[16];
+        int count = 0;
+        auto remaining = static_cast<unsigned int>(value);
+
+        do {
+            digits[count++] = static_cast<char>('0' + remaining % 10);
+            remaining /= 10;
+        } while (remaining != 0);
+
+        while (count > 0) {
+            *out++ = digits[--count];
+        }
+    }
+}  // namespace
+
+bool fen::LoadPosition(BoardArea& board, const char* fen, std::size_t length) noexcept
+{
+    const char* cursor = fen;
+    const char* const end = fen + length;
+    Field placement;
+    Field side;
+    Field castling;
+    Field en_passant;
+    std::uint8_t rights;
+    int square;
+
+    board.ClearArea();
+
+    if (!NextField(cursor, end, placement) || !NextField(cursor, end, side) ||
+        !NextField(cursor, end, castling) || !NextField(cursor, end, en_passant) ||
+        !LoadPlacement(board, placement) || !(side == "w" || side == "b") ||
+        !LoadCastlingRights(castling, rights) || !LoadEnPassantSquare(en_passant, square)) {
+        board.ClearArea();
+        return false;
+    }
+
+    board.SetSideToMove(side == "w" ? PieceColour::WHITE : PieceColour::BLACK);
+    if (!setup::FinishPosition(board, rights, square)) {
+        board.ClearArea();
+        return false;
+    }
+
+    // The move counters are optional, plenty of FEN strings out there omit them, and EPD puts
+    // operations in their place.
+    Field field;
+    int counter;
+    if (NextField(cursor, end, field) && LoadCounter(field, counter)) {
+        board.SetHalfmoveClock(counter);
+        if (NextField(cursor, end, field) && LoadCounter(field, counter)) {
+            board.SetFullmoveNumber(counter);
+        }
+    }
+
+    return true;
+}
+
+bool fen::LoadPosition(BoardArea& board, const char* fen) noexcept
+{
+    return LoadPosition(board, fen, std::strlen(fen));
+}
+
+bool fen::LoadPosition(BoardArea& board, const std::string& fen) noexcept
+{
+    return LoadPosition(board, fen.data(), fen.size());
+}
+
+std::size_t fen::SavePosition(const BoardArea& board, char* buffer) noexcept
+{
+    char* out = buffer;
+
+    for (int y = bitboard::kBoardSize - 1; y >= 0; y--) {
+        int empty = 0;
+
+        for (int x = 0; x < bitboard::kBoardSize; x++) {
+            const Piece piece = board.GetPiece(Position2D(x, y).ToSquareIndex());
+            if (piece == Piece::NONE) {
+                empty++;
+                continue;
+            }
+
+            if (empty > 0) {
+                *out++ = static_cast<char>('0' + empty);
+                empty = 0;
+            }
+            const char letter = kPieceLetters[static_cast<int>(GetPieceType(piece))];
+            *out++ = GetPieceColour(piece) == PieceColour::WHITE
+                         ? static_cast<char>(letter - 'a' + 'A')
+                         : letter;
+        }
+
+        if (empty > 0) {
+            *out++ = static_cast<char>('0' + empty);
+        }
+        if (y > 0) {
+            *out++ = '/';
+        }
+    }
+
+    *out++ = ' ';
+    *out++ = board.GetSideToMove() == PieceColour::WHITE ? 'w' : 'b';
+    *out++ = ' ';
+
+    const std::uint8_t rights = board.GetCastlingRights();
+    if (rights == BoardArea::NO_CASTLING) {
+        *out++ = '-';
+    }
+    else {
+        constexpr const char* kCastlingLetters = "KQkq";
+        for (int i = 0; i < 4; i++) {
+            if ((rights & (1 << i)) != 0) {
+                *out++ = kCastlingLetters[i];
+            }
+        }
+    }
+    *out++ = ' ';
+
+    const int en_passant = board.GetEnPassantSquare();
+    if (en_passant == BoardArea::kNoSquare) {
+        *out++ = '-';
+    }
+    else {
+        const Position2D position = Position2D::FromSquareIndex(en_passant);
+        *out++ = static_cast<char>('a' + position.x);
+        *out++ = static_cast<char>('1' + position.y);
+    }
+
+    *out++ = ' ';
+    SaveNumber(out, board.GetHalfmoveClock());
+    *out++ = ' ';
+    SaveNumber(out, board.GetFullmoveNumber());
+    *out = '\0';
+
+    return static_cast<std::size_t>(out - buffer);
+}
+
+std::string fen::SavePosition(const BoardArea& board) noexcept
+{
+    char buffer[kMaxLength];
+    const std::size_t length = SavePosition(board, buffer);
+    return std::string(buffer, length);
+}
@@ -0,0 +1,99 @@
+/**
+ * @file    fen.hpp
+ *
+ * @brief   Reading and writing positions in the Forsyth-Edwards Notation.
+ *
+ * @section DESCRIPTION
+ *
+ * FEN describes a whole position in a single line of text: the piece placement, the side to
+ * move, the castling rights, the en passant square and the two move counters.
+ *
+ * Batch tools read and write millions of positions, so the text is parsed in place and written
+ * to a caller's buffer, without any allocation.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+#include "board_area.hpp"
+
+namespace raychess
+{
+    namespace fen
+    {
+        /**
+         * @brief   The starting position of a game of chess.
+         */
+        constexpr const char* kStartingPosition =
+            "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1";
+
+        /**
+         * @brief   Size of a buffer large enough for any FEN string, the terminating null included.
+         */
+        constexpr std::size_t kMaxLength = 128;
+
+        /**
+         * @brief       Sets up a board from a FEN string.
+         *
+         * The move counters may be left out, in which case they default to 0 and 1, and anything
+         * after them (such as EPD operations) is ignored. The board must be 8x8.
+         *
+         * Each side must have one king and no pawns on the first or last rank, the side not to
+         * move must not be in check and an en passant square must lie behind a pawn just pushed
+         * two squares. Castling rights whose king or rook is not on its starting square are
+         * dropped, as is an en passant square no pawn can capture onto, so that the board gets
+         * the same key as when the position is reached by playing moves. Pawns off their
+         * starting rank count as moved.
+         *
+         * @param[out]  board   The board to set up. It is cleared first.
+         * @param[in]   fen     The FEN string, which needn't be null terminated.
+         * @param[in]   length  The length of the FEN string.
+         *
+         * @return      True if the string was read successfully, false otherwise. The board is
+         * left cleared on failure.
+         */
+        bool LoadPosition(BoardArea& board, const char* fen, std::size_t length) noexcept;
+
+        /**
+         * @brief       Sets up a board from a null terminated FEN string.
+         *
+         * @param[out]  board  The board to set up. It is cleared first.
+         * @param[in]   fen    The FEN string.
+         *
+         * @return      True if the string was read successfully, false otherwise.
+         */
+        bool LoadPosition(BoardArea& board, const char* fen) noexcept;
+
+        /**
+         * @brief       Sets up a board from a FEN string.
+         *
+         * @param[out]  board  The board to set up. It is cleared first.
+         * @param[in]   fen    The FEN string.
+         *
+         * @return      True if the string was read successfully, false otherwise.
+         */
+        bool LoadPosition(BoardArea& board, const std::string& fen) noexcept;
+
+        /**
+         * @brief       Writes the position of a board as a FEN string.
+         *
+         * @param[in]   board   The board holding the position.
+         * @param[out]  buffer  The buffer to write to, at least kMaxLength characters. The string
+         * is null terminated.
+         *
+         * @return      The length of the string written, without the terminating null.
+         */
+        std::size_t SavePosition(const BoardArea& board, char* buffer) noexcept;
+
+        /**
+         * @brief       Gets the position of a board as a FEN string.
+         *
+         * @param[in]   board  The board holding the position.
+         *
+         * @return      The FEN string.
+         */
+        std::string SavePosition(const BoardArea& board) noexcept;
+    }  // namespace fen
+}  // namespace raychess
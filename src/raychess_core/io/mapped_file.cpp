@@ -0,0 +1,132 @@
+/**
+ * @file    mapped_file.cpp
+ *
+ * @brief   Read-only memory mapping of a file.
+ *
+ * @section DESCRIPTION
+ *
+ * Uses the file mapping API on Windows and mmap() everywhere else.
+ */
+
+#include "mapped_file.hpp"
+
+#if defined(_WIN32)
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+using namespace raychess;
+
+#if defined(_WIN32)
+
+MappedFile::MappedFile() noexcept
+    : data_(nullptr), size_(0), file_(INVALID_HANDLE_VALUE), mapping_(nullptr)
+{
+}
+
+MappedFile::~MappedFile() { Close(); }
+
+bool MappedFile::Open(const std::string& path) noexcept
+{
+    Close();
+
+    file_ = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                        FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    LARGE_INTEGER size;
+    if (file_ == INVALID_HANDLE_VALUE || !GetFileSizeEx(file_, &size)) {
+        Close();
+        return false;
+    }
+
+    // Empty files can't be mapped, but there is nothing to read from them anyway.
+    size_ = static_cast<std::size_t>(size.QuadPart);
+    if (size_ == 0) {
+        return true;
+    }
+
+    mapping_ = CreateFileMappingA(file_, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (mapping_ != nullptr) {
+        data_ = static_cast<const char*>(MapViewOfFile(mapping_, FILE_MAP_READ, 0, 0, 0));
+    }
+    if (data_ == nullptr) {
+        Close();
+        return false;
+    }
+
+    return true;
+}
+
+void MappedFile::Close(void) noexcept
+{
+    if (data_ != nullptr) {
+        UnmapViewOfFile(data_);
+    }
+    if (mapping_ != nullptr) {
+        CloseHandle(mapping_);
+    }
+    if (file_ != INVALID_HANDLE_VALUE) {
+        CloseHandle(file_);
+    }
+
+    data_ = nullptr;
+    size_ = 0;
+    file_ = INVALID_HANDLE_VALUE;
+    mapping_ = nullptr;
+}
+
+#else
+
+MappedFile::MappedFile() noexcept : data_(nullptr), size_(0) {}
+
+MappedFile::~MappedFile() { Close(); }
+
+bool MappedFile::Open(const std::string& path) noexcept
+{
+    Close();
+
+    const int file = open(path.c_str(), O_RDONLY);
+    if (file < 0) {
+        return false;
+    }
+
+    struct stat status;
+    if (fstat(file, &status) != 0) {
+        close(file);
+        return false;
+    }
+
+    // Empty files can't be mapped, but there is nothing to read from them anyway.
+    size_ = static_cast<std::size_t>(status.st_size);
+    if (size_ != 0) {
+        void* data = mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, file, 0);
+        if (data == MAP_FAILED) {
+            size_ = 0;
+        }
+        else {
+            data_ = static_cast<const char*>(data);
+            madvise(data, size_, MADV_SEQUENTIAL);
+        }
+    }
+
+    // The mapping stays valid after the file is closed.
+    close(file);
+    return data_ != nullptr || status.st_size == 0;
+}
+
+void MappedFile::Close(void) noexcept
+{
+    if (data_ != nullptr) {
+        munmap(const_cast<char*>(data_), size_);
+    }
+
+    data_ = nullptr;
+    size_ = 0;
+}
+
+#endif
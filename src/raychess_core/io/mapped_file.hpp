@@ -0,0 +1,78 @@
+/**
+ * @file    mapped_file.hpp
+ *
+ * @brief   Read-only memory mapping of a file.
+ *
+ * @section DESCRIPTION
+ *
+ * Game archives run to several gigabytes, so they are mapped into memory rather than read into a
+ * buffer. The operating system pages the file in as it is read and drops the pages again when
+ * memory gets short.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+namespace raychess
+{
+    /**
+     * @brief   A file mapped into memory for reading.
+     */
+    class MappedFile
+    {
+    public:
+        /**
+         * @brief       Default constructor. No file is mapped.
+         */
+        MappedFile() noexcept;
+
+        /**
+         * @brief       Destructor. Unmaps the file, if any.
+         */
+        ~MappedFile();
+
+        MappedFile(const MappedFile&) = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+
+        /**
+         * @brief       Maps a file, unmapping the previous one.
+         *
+         * The mapping is set up for reading the file front to back.
+         *
+         * @param[in]   path  The path of the file.
+         *
+         * @return      True if the file was mapped, false otherwise.
+         */
+        bool Open(const std::string& path) noexcept;
+
+        /**
+         * @brief       Unmaps the file, if any.
+         */
+        void Close(void) noexcept;
+
+        /**
+         * @brief       Gets the contents of the file.
+         *
+         * @return      The first byte of the file, or nullptr if no file (or an empty one) is
+         * mapped.
+         */
+        const char* GetData(void) const noexcept { return data_; }
+
+        /**
+         * @brief       Gets the size of the file.
+         *
+         * @return      The size of the file in bytes, 0 if no file is mapped.
+         */
+        std::size_t GetSize(void) const noexcept { return size_; }
+
+    private:
+        const char* data_;  ///< The mapped contents of the file.
+        std::size_t size_;  ///< The size of the file in bytes.
+#if defined(_WIN32)
+        void* file_;     ///< Handle of the file.
+        void* mapping_;  ///< Handle of the file mapping.
+#endif
+    };
+}  // namespace raychess
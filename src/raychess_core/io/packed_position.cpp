@@ -0,0 +1,133 @@
+/**
+ * @file    packed_position.cpp
+ *
+ * @brief   A compact binary encoding of positions.
+ *
+ * @section DESCRIPTION
+ *
+ * The 4-bit piece codes are the values of the Piece enumeration, which fit in a nibble.
+ */
+
+#include "packed_position.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+#include "position_setup.hpp"
+
+using namespace raychess;
+
+namespace
+{
+    constexpr std::uint8_t kNoEnPassant = 0xff;  ///< Packed en passant square meaning none.
+    constexpr std::uint8_t kStateMask = 0x1f;    ///< The bits of the state in use.
+
+    /**
+     * @brief       Stores a value as little-endian bytes.
+     *
+     * @param[in]   value  The value.
+     * @param[out]  bytes  The bytes to store to.
+     * @param[in]   count  The number of bytes to store.
+     */
+    void StoreLittleEndian(std::uint64_t value, std::uint8_t* bytes, int count) noexcept
+    {
+        for (int i = 0; i < count; i++) {
+            bytes[i] = static_cast<std::uint8_t>(value >> (8 * i));
+        }
+    }
+
+    /**
+     * @brief       Loads a value from little-endian bytes.
+     *
+     * @param[in]   bytes  The bytes to load from.
+     * @param[in]   count  The number of bytes to load.
+     *
+     * @return      The value.
+     */
+    std::uint64_t LoadLittleEndian(const std::uint8_t* bytes, int count) noexcept
+    {
+        std::uint64_t value = 0;
+        for (int i = 0; i < count; i++) {
+            value |= static_cast<std::uint64_t>(bytes[i]) << (8 * i);
+        }
+        return value;
+    }
+
+    /**
+     * @brief       Checks whether a 4-bit code stands for a piece.
+     *
+     * @param[in]   code  The code, below 16.
+     *
+     * @return      True if the code is the value of a piece, false otherwise.
+     */
+    bool IsPieceCode(unsigned int code) noexcept
+    {
+        return (code & 7) <= static_cast<unsigned int>(PieceType::KING);
+    }
+}  // namespace
+
+bool packed::SavePosition(const BoardArea& board, PackedPosition& packed) noexcept
+{
+    const Bitboard occupied = board.GetOccupiedBitboard();
+    if (bitboard::PopCount(occupied) > PackedPosition::kMaxPieces) {
+        return false;
+    }
+
+    std::memset(&packed, 0, sizeof(packed));
+    StoreLittleEndian(occupied, packed.occupancy, sizeof(packed.occupancy));
+
+    int index = 0;
+    for (Bitboard squares = occupied; squares != bitboard::kEmpty; index++) {
+        const auto code = static_cast<std::uint8_t>(board.GetPiece(bitboard::PopLsb(squares)));
+        packed.pieces[index / 2] |= static_cast<std::uint8_t>(code << (4 * (index % 2)));
+    }
+
+    packed.state = static_cast<std::uint8_t>(
+        (board.GetSideToMove() == PieceColour::BLACK ? 1 : 0) | (board.GetCastlingRights() << 1));
+    packed.en_passant = board.GetEnPassantSquare() == BoardArea::kNoSquare
+                            ? kNoEnPassant
+                            : static_cast<std::uint8_t>(board.GetEnPassantSquare());
+    StoreLittleEndian(std::min(board.GetHalfmoveClock(), 0xffff), packed.halfmove_clock,
+                      sizeof(packed.halfmove_clock));
+    StoreLittleEndian(std::min(board.GetFullmoveNumber(), 0xffff), packed.fullmove_number,
+                      sizeof(packed.fullmove_number));
+
+    return true;
+}
+
+bool packed::LoadPosition(BoardArea& board, const PackedPosition& packed) noexcept
+{
+    board.ClearArea();
+
+    Bitboard occupied = LoadLittleEndian(packed.occupancy, sizeof(packed.occupancy));
+    if (bitboard::PopCount(occupied) > PackedPosition::kMaxPieces ||
+        (packed.state & ~kStateMask) != 0 ||
+        (packed.en_passant != kNoEnPassant && packed.en_passant >= bitboard::kSquareCount)) {
+        return false;
+    }
+
+    for (int index = 0; occupied != bitboard::kEmpty; index++) {
+        const unsigned int code = (packed.pieces[index / 2] >> (4 * (index % 2))) & 0xf;
+        if (!IsPieceCode(code)) {
+            board.ClearArea();
+            return false;
+        }
+        board.AddPiece(static_cast<Piece>(code), bitboard::PopLsb(occupied));
+    }
+
+    // The same checks as for FEN, so that a record which couldn't have been written from a
+    // legal position is rejected rather than given a key no game reaches.
+    board.SetSideToMove((packed.state & 1) != 0 ? PieceColour::BLACK : PieceColour::WHITE);
+    if (!setup::FinishPosition(board, static_cast<std::uint8_t>(packed.state >> 1),
+                               packed.en_passant == kNoEnPassant ? BoardArea::kNoSquare
+                                                                 : packed.en_passant)) {
+        board.ClearArea();
+        return false;
+    }
+    board.SetHalfmoveClock(static_cast<int>(
+        LoadLittleEndian(packed.halfmove_clock, sizeof(packed.halfmove_clock))));
+    board.SetFullmoveNumber(static_cast<int>(
+        LoadLittleEndian(packed.fullmove_number, sizeof(packed.fullmove_number))));
+
+    return true;
+}
@@ -0,0 +1,75 @@
+/**
+ * @file    packed_position.hpp
+ *
+ * @brief   A compact binary encoding of positions.
+ *
+ * @section DESCRIPTION
+ *
+ * A packed position takes 32 bytes: the occupied squares as a 64-bit mask, the pieces on them as
+ * 4-bit codes in square order, and the side to move, castling rights, en passant square and move
+ * counters. That is less than half the size of a typical FEN string, and it is unpacked without
+ * any parsing.
+ *
+ * Multi-byte values are stored little-endian byte by byte, so packed positions can be written to
+ * files and read back on any machine.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+#include "board_area.hpp"
+
+namespace raychess
+{
+    /**
+     * @brief   A position packed into 32 bytes.
+     */
+    struct PackedPosition
+    {
+        static constexpr int kMaxPieces = 32;  ///< Most pieces a packed position holds.
+
+        std::uint8_t occupancy[8];        ///< The occupied squares, A1 in the lowest bit.
+        std::uint8_t pieces[16];          ///< The pieces on the occupied squares, two per byte.
+        std::uint8_t state;               ///< Black to move in bit 0, castling rights above.
+        std::uint8_t en_passant;          ///< The en passant square, 0xff if there is none.
+        std::uint8_t halfmove_clock[2];   ///< The halfmove clock.
+        std::uint8_t fullmove_number[2];  ///< The fullmove number.
+        std::uint8_t reserved[2];         ///< Zero.
+    };
+
+    static_assert(sizeof(PackedPosition) == 32, "Packed positions take exactly 32 bytes");
+    static_assert(std::is_trivially_copyable<PackedPosition>::value,
+                  "Packed positions are copied to and from files as raw bytes");
+
+    namespace packed
+    {
+        /**
+         * @brief       Packs the position of a board.
+         *
+         * Move counters above 65535 are stored as 65535.
+         *
+         * @param[in]   board   The board holding the position. It must be 8x8.
+         * @param[out]  packed  The packed position.
+         *
+         * @return      True if the position was packed, false if it has more than
+         * PackedPosition::kMaxPieces pieces.
+         */
+        bool SavePosition(const BoardArea& board, PackedPosition& packed) noexcept;
+
+        /**
+         * @brief       Sets up a board from a packed position.
+         *
+         * The position is checked and cleaned up like a FEN string by fen::LoadPosition().
+         *
+         * @param[out]  board   The board to set up, which must be 8x8. It is cleared first.
+         * @param[in]   packed  The packed position.
+         *
+         * @return      True if the position was unpacked, false if it is corrupt. The board is
+         * left cleared on failure.
+         */
+        bool LoadPosition(BoardArea& board, const PackedPosition& packed) noexcept;
+    }  // namespace packed
+}  // namespace raychess
@@ -0,0 +1,473 @@
+/**
+ * @file    pgn.cpp
+ *
+ * @brief   Reading games in the Portable Game Notation.
+ *
+ * @section DESCRIPTION
+ *
+ * The text is read in place, token by token. SAN moves are resolved against the position, which
+ * the game is replayed on as it is read.
+ */
+
+#include "pgn.hpp"
+
+#include <cstring>
+
+#include "fen.hpp"
+#include "move_generator.hpp"
+
+using namespace raychess;
+
+namespace
+{
+    constexpr const char* kPieceLetters = "PNBRQK";  ///< Letters of the pieces, by PieceType.
+
+    /**
+     * @brief       Checks whether a character is one of a set.
+     *
+     * @param[in]   c    The character.
+     * @param[in]   set  The characters of the set.
+     *
+     * @return      True if the character is in the set, false otherwise. The terminating null
+     * character of the set is not part of it.
+     */
+    bool IsOneOf(char c, const char* set) noexcept
+    {
+        return c != '\0' && std::strchr(set, c) != nullptr;
+    }
+
+    /**
+     * @brief       Checks whether a character ends a token of the movetext.
+     *
+     * @param[in]   c  The character.
+     *
+     * @return      True if the character is whitespace or starts another token, false otherwise.
+     */
+    bool IsTokenEnd(char c) noexcept { return IsOneOf(c, " \t\r\n{}();[$"); }
+
+    /**
+     * @brief       Reads the piece letter of a piece moving or promoted to.
+     *
+     * @param[in]   c      The letter, upper case. Only pawns are written without.
+     * @param[out]  type   The type of the piece.
+     *
+     * @return      True if the letter names a piece, false otherwise.
+     */
+    bool ParsePieceLetter(char c, PieceType& type) noexcept
+    {
+        if (!IsOneOf(c, kPieceLetters)) {
+            return false;
+        }
+
+        type = static_cast<PieceType>(std::strchr(kPieceLetters, c) - kPieceLetters);
+        return true;
+    }
+
+    /**
+     * @brief       Checks whether a token is castling, and to which side.
+     *
+     * @param[in]   begin  The first character of the token.
+     * @param[in]   end    One past the last character of the token.
+     * @param[out]  flag   The flag of the castling move.
+     *
+     * @return      True if the token is castling, false otherwise.
+     */
+    bool ParseCastling(const char* begin, const char* end, Move::Flag& flag) noexcept
+    {
+        const std::ptrdiff_t length = end - begin;
+        if (length != 3 && length != 5) {
+            return false;
+        }
+
+        for (std::ptrdiff_t i = 0; i < length; i++) {
+            if (i % 2 == 0 ? !IsOneOf(begin[i], "O0") : begin[i] != '-') {
+                return false;
+            }
+        }
+
+        flag = (length == 3 ? Move::Flag::KING_CASTLE : Move::Flag::QUEEN_CASTLE);
+        return true;
+    }
+
+    /**
+     * @brief       Reads a game termination marker.
+     *
+     * @param[in]   begin   The first character of the token.
+     * @param[in]   end     One past the last character of the token.
+     * @param[out]  result  The result of the game.
+     *
+     * @return      True if the token is a termination marker, false otherwise.
+     */
+    bool ParseResult(const char* begin, const char* end, pgn::Result& result) noexcept
+    {
+        const std::size_t length = static_cast<std::size_t>(end - begin);
+        const auto is = [begin, length](const char* marker) {
+            return std::strlen(marker) == length && std::memcmp(begin, marker, length) == 0;
+        };
+
+        if (is("1-0")) {
+            result = pgn::Result::WHITE_WINS;
+        }
+        else if (is("0-1")) {
+            result = pgn::Result::BLACK_WINS;
+        }
+        else if (is("1/2-1/2")) {
+            result = pgn::Result::DRAW;
+        }
+        else if (is("*")) {
+            result = pgn::Result::UNKNOWN;
+        }
+        else {
+            return false;
+        }
+
+        return true;
+    }
+}  // namespace
+
+Move pgn::ParseSan(const BoardArea& board, const char* san, std::size_t length) noexcept
+{
+    const char* begin = san;
+    const char* end = san + length;
+
+    // Checks and annotations such as "+", "#" or "!?" don't help finding the move.
+    while (end != begin && IsOneOf(end[-1], "+#!?")) {
+        end--;
+    }
+
+    // Generating all moves costs more than the rest of the replay, so the few moves the SAN can
+    // stand for are built directly and only checked for legality.
+    const MoveGenerator generator(board);
+    const PieceColour us = board.GetSideToMove();
+
+    Move::Flag castling;
+    if (ParseCastling(begin, end, castling)) {
+        const int king = (us == PieceColour::WHITE ? 4 : 60);
+        const Move move(king, castling == Move::Flag::KING_CASTLE ? king + 2 : king - 2, castling);
+        return generator.IsLegal(move) ? move : Move();
+    }
+
+    PieceType type = PieceType::PAWN;
+    if (begin != end && ParsePieceLetter(*begin, type)) {
+        begin++;
+    }
+
+    // The promotion piece is sometimes written in lower case, or without the equals sign.
+    bool promotion = false;
+    PieceType promotion_type = PieceType::QUEEN;
+    if (end - begin >= 3 && IsOneOf(end[-2], "=12345678") &&
+        ParsePieceLetter(static_cast<char>(end[-1] >= 'a' ? end[-1] - 'a' + 'A' : end[-1]),
+                         promotion_type)) {
+        if (promotion_type == PieceType::PAWN || promotion_type == PieceType::KING) {
+            return Move();
+        }
+        promotion = true;
+        end -= (end[-2] == '=' ? 2 : 1);
+    }
+
+    if (end - begin < 2 || end[-2] < 'a' || end[-2] > 'h' || end[-1] < '1' || end[-1] > '8') {
+        return Move();
+    }
+    const int to = Position2D(end[-2] - 'a', end[-1] - '1').ToSquareIndex();
+    end -= 2;
+
+    // Whatever is left tells apart pieces of the same type reaching the same square.
+    int from_file = -1;
+    int from_rank = -1;
+    for (const char* c = begin; c != end; c++) {
+        if (*c >= 'a' && *c <= 'h') {
+            from_file = *c - 'a';
+        }
+        else if (*c >= '1' && *c <= '8') {
+            from_rank = *c - '1';
+        }
+        else if (!IsOneOf(*c, "x:-")) {
+            return Move();
+        }
+    }
+
+    const Bitboard pieces = board.GetPieceBitboard(us, type);
+    const bool capture = board.GetPiece(to) != Piece::NONE;
+    const bool en_passant = type == PieceType::PAWN && to == board.GetEnPassantSquare();
+    const int forward = (us == PieceColour::WHITE ? bitboard::kBoardSize : -bitboard::kBoardSize);
+
+    Bitboard candidates;
+    if (type != PieceType::PAWN || capture || en_passant) {
+        candidates = MoveGenerator::GetAttackersTo(board, to, board.GetOccupiedBitboard()) & pieces;
+    }
+    else {
+        // A pawn pushed twice must have jumped an empty square, which IsLegal() checks. No pawn
+        // is pushed onto the first rank, where the square behind is off the board.
+        const int single = to - forward;
+        if (single < 0 || single >= bitboard::kSquareCount) {
+            return Move();
+        }
+        const int from = (board.GetPiece(single) == Piece::NONE ? single - forward : single);
+        candidates = (from >= 0 && from < bitboard::kSquareCount ? bitboard::SquareBit(from)
+                                                                  : bitboard::kEmpty) &
+                     pieces;
+    }
+
+    Move found;
+    while (candidates != bitboard::kEmpty) {
+        const int from = bitboard::PopLsb(candidates);
+        const Position2D position = Position2D::FromSquareIndex(from);
+        if ((from_file >= 0 && position.x != from_file) ||
+            (from_rank >= 0 && position.y != from_rank)) {
+            continue;
+        }
+
+        Move::Flag flag = capture ? Move::Flag::CAPTURE : Move::Flag::QUIET;
+        if (promotion) {
+            flag = Move::PromotionFlag(promotion_type, capture);
+        }
+        else if (en_passant && !capture) {
+            flag = Move::Flag::EN_PASSANT;
+        }
+        else if (type == PieceType::PAWN && (to - from) == 2 * forward) {
+            flag = Move::Flag::DOUBLE_PAWN_PUSH;
+        }
+
+        const Move move(from, to, flag);
+        if (!generator.IsLegal(move)) {
+            continue;
+        }
+
+        // An ambiguous move is as good as no move.
+        if (found.IsValid()) {
+            return Move();
+        }
+        found = move;
+    }
+
+    return found;
+}
+
+pgn::Reader::Reader(const char* text, std::size_t length) noexcept
+    : text_(text), end_(text + length), cursor_(text), board_(8, 8), skipped_games_(0)
+{
+}
+
+bool pgn::Reader::ReadGame(Game& game, const PositionCallback& callback) noexcept
+{
+    for (;;) {
+        game.fen.clear();
+        game.moves.clear();
+        game.result = Result::UNKNOWN;
+
+        SkipSpace();
+        if (cursor_ == end_) {
+            return false;
+        }
+
+        // The tag section of a game is read to its end even if a tag can't be read, so that
+        // the game can be skipped from its movetext.
+        bool valid = true;
+        while (cursor_ != end_ && *cursor_ == '[') {
+            if (!ReadTag(game)) {
+                valid = false;
+                while (cursor_ != end_ && *cursor_ != '\n') {
+                    cursor_++;
+                }
+            }
+            SkipSpace();
+        }
+
+        if (valid) {
+            valid = game.fen.empty() ? fen::LoadPosition(board_, fen::kStartingPosition)
+                                     : fen::LoadPosition(board_, game.fen);
+        }
+        if (valid && ReadMovetext(game)) {
+            // Positions are only passed once the whole game is known to be readable, so the
+            // moves are replayed from the start.
+            if (callback) {
+                ReplayGame(game, callback);
+            }
+            return true;
+        }
+
+        skipped_games_++;
+        SkipGame();
+    }
+}
+
+void pgn::Reader::SkipSpace(void) noexcept
+{
+    while (cursor_ != end_) {
+        if (*cursor_ == '%' && IsLineStart()) {
+            while (cursor_ != end_ && *cursor_ != '\n') {
+                cursor_++;
+            }
+        }
+        else if (IsOneOf(*cursor_, " \t\r\n")) {
+            cursor_++;
+        }
+        else {
+            return;
+        }
+    }
+}
+
+bool pgn::Reader::ReadTag(Game& game) noexcept
+{
+    cursor_++;
+    while (cursor_ != end_ && IsOneOf(*cursor_, " \t")) {
+        cursor_++;
+    }
+
+    const char* name = cursor_;
+    while (cursor_ != end_ && !IsOneOf(*cursor_, " \t\"]\n")) {
+        cursor_++;
+    }
+    const std::size_t name_length = static_cast<std::size_t>(cursor_ - name);
+
+    while (cursor_ != end_ && IsOneOf(*cursor_, " \t")) {
+        cursor_++;
+    }
+    if (cursor_ == end_ || *cursor_ != '"') {
+        return false;
+    }
+
+    const char* value = ++cursor_;
+    while (cursor_ != end_ && *cursor_ != '"' && *cursor_ != '\n') {
+        // A backslash escapes a quote or another backslash.
+        if (*cursor_ == '\\' && end_ - cursor_ > 1) {
+            cursor_++;
+        }
+        cursor_++;
+    }
+    if (cursor_ == end_ || *cursor_ != '"') {
+        return false;
+    }
+    const char* value_end = cursor_++;
+
+    while (cursor_ != end_ && IsOneOf(*cursor_, " \t")) {
+        cursor_++;
+    }
+    if (cursor_ == end_ || *cursor_ != ']') {
+        return false;
+    }
+    cursor_++;
+
+    // Only the starting position matters for replaying the game, FEN has no escapes.
+    if (name_length == 3 && std::memcmp(name, "FEN", 3) == 0) {
+        game.fen.assign(value, value_end);
+    }
+
+    return true;
+}
+
+bool pgn::Reader::ReadMovetext(Game& game) noexcept
+{
+    for (;;) {
+        SkipSpace();
+        if (cursor_ == end_) {
+            return true;
+        }
+
+        switch (*cursor_) {
+            case '[':
+                // The next game's tags, this one had no termination marker.
+                return true;
+
+            case '{':
+                cursor_ = static_cast<const char*>(std::memchr(cursor_, '}', end_ - cursor_));
+                if (cursor_ == nullptr) {
+                    cursor_ = end_;
+                    return false;
+                }
+                cursor_++;
+                continue;
+
+            case ';':
+                while (cursor_ != end_ && *cursor_ != '\n') {
+                    cursor_++;
+                }
+                continue;
+
+            case '(': {
+                // Variations nest, and may hold comments with parentheses of their own.
+                int depth = 0;
+                while (cursor_ != end_) {
+                    const char c = *cursor_++;
+                    if (c == '(') {
+                        depth++;
+                    }
+                    else if (c == ')' && --depth == 0) {
+                        break;
+                    }
+                    else if (c == '{') {
+                        while (cursor_ != end_ && *cursor_++ != '}') {
+                        }
+                    }
+                }
+                if (depth != 0) {
+                    return false;
+                }
+                continue;
+            }
+
+            case ')':
+            case '}':
+                return false;
+
+            case '$':
+                cursor_++;
+                while (cursor_ != end_ && *cursor_ >= '0' && *cursor_ <= '9') {
+                    cursor_++;
+                }
+                continue;
+
+            default:
+                break;
+        }
+
+        const char* token = cursor_;
+        while (cursor_ != end_ && !IsTokenEnd(*cursor_)) {
+            cursor_++;
+        }
+
+        if (ParseResult(token, cursor_, game.result)) {
+            return true;
+        }
+
+        // Move numbers, such as "12." or "12...", may be written right before the move. Only
+        // castling written with zeros starts with a digit otherwise.
+        const char* san = token;
+        if (!(*san == '0' && cursor_ - san >= 2 && san[1] == '-')) {
+            while (san != cursor_ && *san >= '0' && *san <= '9') {
+                san++;
+            }
+            while (san != cursor_ && *san == '.') {
+                san++;
+            }
+        }
+        if (san == cursor_) {
+            continue;
+        }
+
+        const Move move = ParseSan(board_, san, static_cast<std::size_t>(cursor_ - san));
+        if (!move.IsValid()) {
+            return false;
+        }
+
+        game.moves.push_back(move);
+        board_.ApplyMove(move);
+    }
+}
+
+void pgn::Reader::ReplayGame(const Game& game, const PositionCallback& callback) noexcept
+{
+    fen::LoadPosition(board_, game.fen.empty() ? fen::kStartingPosition : game.fen.c_str());
+    for (const Move move : game.moves) {
+        callback(board_, move);
+        board_.ApplyMove(move);
+    }
+}
+
+void pgn::Reader::SkipGame(void) noexcept
+{
+    while (cursor_ != end_ && !(*cursor_ == '[' && IsLineStart())) {
+        cursor_++;
+    }
+}
@@ -0,0 +1,175 @@
+/**
+ * @file    pgn.hpp
+ *
+ * @brief   Reading games in the Portable Game Notation.
+ *
+ * @section DESCRIPTION
+ *
+ * PGN records a game as a section of tag pairs followed by the moves in Standard Algebraic
+ * Notation (SAN), which only names a move's piece and target square, so the moves have to be
+ * replayed on a board to know which piece made them.
+ *
+ * The reader works on text in memory, typically a whole archive mapped with MappedFile, and reads
+ * it one game at a time without copying it.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "board_area.hpp"
+#include "move.hpp"
+
+namespace raychess
+{
+    namespace pgn
+    {
+        /**
+         * @brief   The result of a game, from its game termination marker.
+         */
+        enum class Result
+        {
+            WHITE_WINS,
+            BLACK_WINS,
+            DRAW,
+            UNKNOWN  ///< The game is unfinished, or has no termination marker.
+        };
+
+        /**
+         * @brief   A game read from PGN.
+         */
+        struct Game
+        {
+            std::string fen;          ///< The starting position, empty for the standard one.
+            std::vector<Move> moves;  ///< The moves of the game, in the order played.
+            Result result;            ///< The result of the game.
+        };
+
+        /**
+         * @brief   Called with every position of a game, before the move played from it.
+         */
+        using PositionCallback = std::function<void(const BoardArea& board, Move move)>;
+
+        /**
+         * @brief       Reads a move in Standard Algebraic Notation.
+         *
+         * Castling may be written with zeros as well as with the letter O, the equals sign of
+         * a promotion may be left out and check and annotation suffixes are ignored.
+         *
+         * @param[in]   board   The board holding the position the move is played from.
+         * @param[in]   san     The move, which needn't be null terminated.
+         * @param[in]   length  The length of the move.
+         *
+         * @return      The move, or "no move" if it isn't exactly one legal move.
+         */
+        Move ParseSan(const BoardArea& board, const char* san, std::size_t length) noexcept;
+
+        /**
+         * @brief   Reads the games of a PGN text one at a time.
+         *
+         * Comments, variations, numeric annotation glyphs and escaped lines are skipped. Games
+         * with a tag or move that can't be read are skipped as a whole and counted. The text is
+         * not copied and must outlive the reader.
+         */
+        class Reader
+        {
+        public:
+            /**
+             * @brief       Constructor.
+             *
+             * @param[in]   text    The PGN text.
+             * @param[in]   length  The length of the text.
+             */
+            Reader(const char* text, std::size_t length) noexcept;
+
+            /**
+             * @brief       Reads the next game.
+             *
+             * The game's containers are reused, so reading every game into the same one saves
+             * allocating them again.
+             *
+             * @param[out]  game      The game read.
+             * @param[in]   callback  Called with every position of the game and the move played
+             * from it, or empty. Only games read completely have their positions passed.
+             *
+             * @return      True if a game was read, false at the end of the text.
+             */
+            bool ReadGame(Game& game,
+                          const PositionCallback& callback = PositionCallback()) noexcept;
+
+            /**
+             * @brief       Gets the number of games skipped because they couldn't be read.
+             *
+             * @return      The number of skipped games.
+             */
+            std::size_t GetSkippedGames(void) const noexcept { return skipped_games_; }
+
+            /**
+             * @brief       Gets how far into the text the reader got.
+             *
+             * @return      The number of bytes read.
+             */
+            std::size_t GetOffset(void) const noexcept
+            {
+                return static_cast<std::size_t>(cursor_ - text_);
+            }
+
+        private:
+            /**
+             * @brief       Skips whitespace and escaped lines.
+             */
+            void SkipSpace(void) noexcept;
+
+            /**
+             * @brief       Reads a tag pair, the cursor being on its opening bracket.
+             *
+             * @param[out]  game  The game the tag belongs to.
+             *
+             * @return      True if the tag was read, false otherwise.
+             */
+            bool ReadTag(Game& game) noexcept;
+
+            /**
+             * @brief       Reads the moves of a game up to and including its termination marker.
+             *
+             * @param[out]  game  The game the moves belong to.
+             *
+             * @return      True if the moves were read, false otherwise.
+             */
+            bool ReadMovetext(Game& game) noexcept;
+
+            /**
+             * @brief       Passes every position of a game read completely to a callback.
+             *
+             * @param[in]   game      The game.
+             * @param[in]   callback  Called with every position of the game and its move.
+             */
+            void ReplayGame(const Game& game, const PositionCallback& callback) noexcept;
+
+            /**
+             * @brief       Skips the rest of the current game's movetext, up to the next tag
+             * section.
+             */
+            void SkipGame(void) noexcept;
+
+            /**
+             * @brief       Checks whether the cursor is at the start of a line.
+             *
+             * @return      True if the cursor is at the start of a line, false otherwise.
+             */
+            bool IsLineStart(void) const noexcept
+            {
+                return cursor_ == text_ || cursor_[-1] == '\n';
+            }
+
+            const char* text_;           ///< The start of the text.
+            const char* end_;            ///< The end of the text.
+            const char* cursor_;         ///< The current position in the text.
+            BoardArea board_;            ///< The board the moves are replayed on.
+            std::size_t skipped_games_;  ///< The number of games skipped.
+        };
+    }  // namespace pgn
+}  // namespace raychess
@@ -0,0 +1,192 @@
+/**
+ * @file    position_file.cpp
+ *
+ * @brief   Files of packed positions, grouped into games.
+ *
+ * @section DESCRIPTION
+ *
+ * The writer streams the positions out through stdio and keeps only the game index in memory.
+ */
+
+#include "position_file.hpp"
+
+#include <cstring>
+
+using namespace raychess;
+
+namespace
+{
+    constexpr char kMagic[8] = {'R', 'A', 'Y', 'C', 'P', 'O', 'S', '1'};  ///< Starts every file.
+    constexpr std::size_t kHeaderSize = 32;                               ///< Size of the header.
+    constexpr std::size_t kIndexEntrySize = 8;  ///< Size of an entry of the game index.
+
+    /**
+     * @brief       Stores a 64-bit value as little-endian bytes.
+     *
+     * @param[in]   value  The value.
+     * @param[out]  bytes  The 8 bytes to store to.
+     */
+    void StoreUint64(std::uint64_t value, std::uint8_t* bytes) noexcept
+    {
+        for (int i = 0; i < 8; i++) {
+            bytes[i] = static_cast<std::uint8_t>(value >> (8 * i));
+        }
+    }
+
+    /**
+     * @brief       Loads a 64-bit value from little-endian bytes.
+     *
+     * @param[in]   bytes  The 8 bytes to load from.
+     *
+     * @return      The value.
+     */
+    std::uint64_t LoadUint64(const std::uint8_t* bytes) noexcept
+    {
+        std::uint64_t value = 0;
+        for (int i = 0; i < 8; i++) {
+            value |= static_cast<std::uint64_t>(bytes[i]) << (8 * i);
+        }
+        return value;
+    }
+}  // namespace
+
+PositionFile::PositionFile() noexcept
+    : positions_(nullptr), index_(nullptr), position_count_(0), game_count_(0)
+{
+}
+
+bool PositionFile::Open(const std::string& path) noexcept
+{
+    Close();
+
+    if (!file_.Open(path) || file_.GetSize() < kHeaderSize ||
+        std::memcmp(file_.GetData(), kMagic, sizeof(kMagic)) != 0) {
+        Close();
+        return false;
+    }
+
+    const auto* header = reinterpret_cast<const std::uint8_t*>(file_.GetData());
+    const std::uint64_t position_count = LoadUint64(header + 8);
+    const std::uint64_t game_count = LoadUint64(header + 16);
+    const std::uint64_t index_offset = LoadUint64(header + 24);
+
+    // Checked by division, so that corrupt counts can't overflow the sizes.
+    const std::uint64_t size = file_.GetSize();
+    if (position_count > (size - kHeaderSize) / sizeof(PackedPosition) ||
+        index_offset != kHeaderSize + position_count * sizeof(PackedPosition) ||
+        game_count > (size - index_offset) / kIndexEntrySize) {
+        Close();
+        return false;
+    }
+
+    // The games must start in order and on positions of the file.
+    const std::uint8_t* index = header + index_offset;
+    std::uint64_t previous_start = 0;
+    for (std::uint64_t game = 0; game < game_count; game++) {
+        const std::uint64_t start = LoadUint64(index + game * kIndexEntrySize);
+        if (start < previous_start || start >= position_count) {
+            Close();
+            return false;
+        }
+        previous_start = start;
+    }
+
+    // Packed positions are plain bytes, so they can be read in place at any alignment.
+    positions_ = reinterpret_cast<const PackedPosition*>(header + kHeaderSize);
+    index_ = index;
+    position_count_ = position_count;
+    game_count_ = game_count;
+    return true;
+}
+
+void PositionFile::Close(void) noexcept
+{
+    file_.Close();
+    positions_ = nullptr;
+    index_ = nullptr;
+    position_count_ = 0;
+    game_count_ = 0;
+}
+
+bool PositionFile::LoadPosition(BoardArea& board, std::uint64_t index) const noexcept
+{
+    return packed::LoadPosition(board, positions_[index]);
+}
+
+std::uint64_t PositionFile::GetGameStart(std::uint64_t game) const noexcept
+{
+    return LoadUint64(index_ + game * kIndexEntrySize);
+}
+
+PositionFileWriter::PositionFileWriter() noexcept
+    : file_(nullptr), position_count_(0), new_game_(true), failed_(false)
+{
+}
+
+PositionFileWriter::~PositionFileWriter() { Close(); }
+
+bool PositionFileWriter::Open(const std::string& path) noexcept
+{
+    Close();
+
+    file_ = std::fopen(path.c_str(), "wb");
+    if (file_ == nullptr) {
+        return false;
+    }
+
+    position_count_ = 0;
+    game_starts_.clear();
+    new_game_ = true;
+
+    // The header is written again with the actual counts on closing.
+    const std::uint8_t header[kHeaderSize] = {};
+    failed_ = std::fwrite(header, 1, sizeof(header), file_) != sizeof(header);
+    return !failed_;
+}
+
+bool PositionFileWriter::Append(const BoardArea& board) noexcept
+{
+    PackedPosition packed;
+    if (file_ == nullptr || !packed::SavePosition(board, packed)) {
+        return false;
+    }
+
+    if (std::fwrite(&packed, sizeof(packed), 1, file_) != 1) {
+        failed_ = true;
+        return false;
+    }
+
+    if (new_game_) {
+        game_starts_.push_back(position_count_);
+        new_game_ = false;
+    }
+    position_count_++;
+    return true;
+}
+
+void PositionFileWriter::StartGame(void) noexcept { new_game_ = true; }
+
+bool PositionFileWriter::Close(void) noexcept
+{
+    if (file_ == nullptr) {
+        return false;
+    }
+
+    for (const std::uint64_t start : game_starts_) {
+        std::uint8_t entry[kIndexEntrySize];
+        StoreUint64(start, entry);
+        failed_ |= std::fwrite(entry, 1, sizeof(entry), file_) != sizeof(entry);
+    }
+
+    std::uint8_t header[kHeaderSize];
+    std::memcpy(header, kMagic, sizeof(kMagic));
+    StoreUint64(position_count_, header + 8);
+    StoreUint64(game_starts_.size(), header + 16);
+    StoreUint64(kHeaderSize + position_count_ * sizeof(PackedPosition), header + 24);
+    failed_ |= std::fseek(file_, 0, SEEK_SET) != 0 ||
+               std::fwrite(header, 1, sizeof(header), file_) != sizeof(header);
+
+    failed_ |= std::fclose(file_) != 0;
+    file_ = nullptr;
+    return !failed_;
+}
@@ -0,0 +1,178 @@
+/**
+ * @file    position_file.hpp
+ *
+ * @brief   Files of packed positions, grouped into games.
+ *
+ * @section DESCRIPTION
+ *
+ * A position file is a header, the packed positions one after another, and an index of where
+ * every game starts:
+ *
+ * - Header, 32 bytes: the magic "RAYCPOS1", the number of positions, the number of games and the
+ *   offset of the index, each 64 bits little-endian.
+ * - Positions, 32 bytes each, see PackedPosition.
+ * - Index, 64 bits little-endian per game: the number of its first position.
+ *
+ * All positions have the same size, so any of them is found right away by its number, and the
+ * index does the same for games. Files are read memory-mapped, so only the pages actually read
+ * are loaded.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "board_area.hpp"
+#include "mapped_file.hpp"
+#include "packed_position.hpp"
+
+namespace raychess
+{
+    /**
+     * @brief   Reads a position file.
+     */
+    class PositionFile
+    {
+    public:
+        /**
+         * @brief       Default constructor. No file is open.
+         */
+        PositionFile() noexcept;
+
+        /**
+         * @brief       Opens a position file, closing the previous one.
+         *
+         * @param[in]   path  The path of the file.
+         *
+         * @return      True if the file was opened, false if it can't be read or isn't a
+         * complete position file, e.g. because its games don't start in order on its positions.
+         */
+        bool Open(const std::string& path) noexcept;
+
+        /**
+         * @brief       Closes the file, if any.
+         */
+        void Close(void) noexcept;
+
+        /**
+         * @brief       Gets the number of positions.
+         *
+         * @return      The number of positions in the file.
+         */
+        std::uint64_t GetPositionCount(void) const noexcept { return position_count_; }
+
+        /**
+         * @brief       Gets the number of games.
+         *
+         * @return      The number of games in the file.
+         */
+        std::uint64_t GetGameCount(void) const noexcept { return game_count_; }
+
+        /**
+         * @brief       Gets a packed position.
+         *
+         * @param[in]   index  The number of the position, below GetPositionCount().
+         *
+         * @return      The packed position.
+         */
+        const PackedPosition& GetPosition(std::uint64_t index) const noexcept
+        {
+            return positions_[index];
+        }
+
+        /**
+         * @brief       Sets up a board from a position.
+         *
+         * @param[out]  board  The board to set up, which must be 8x8.
+         * @param[in]   index  The number of the position, below GetPositionCount().
+         *
+         * @return      True if the position was set up, false if it is corrupt.
+         */
+        bool LoadPosition(BoardArea& board, std::uint64_t index) const noexcept;
+
+        /**
+         * @brief       Gets the number of the first position of a game.
+         *
+         * The positions of a game run up to the first one of the next game, or to the end of the
+         * file for the last game.
+         *
+         * @param[in]   game  The number of the game, below GetGameCount().
+         *
+         * @return      The number of the game's first position.
+         */
+        std::uint64_t GetGameStart(std::uint64_t game) const noexcept;
+
+    private:
+        MappedFile file_;                  ///< The mapped file.
+        const PackedPosition* positions_;  ///< The positions, in the mapped file.
+        const std::uint8_t* index_;        ///< The index of the games, in the mapped file.
+        std::uint64_t position_count_;     ///< The number of positions.
+        std::uint64_t game_count_;         ///< The number of games.
+    };
+
+    /**
+     * @brief   Writes a position file.
+     *
+     * Positions are appended one at a time. The header and the index are only written when the
+     * file is closed, a file which isn't closed properly can't be opened.
+     */
+    class PositionFileWriter
+    {
+    public:
+        /**
+         * @brief       Default constructor. No file is open.
+         */
+        PositionFileWriter() noexcept;
+
+        /**
+         * @brief       Destructor. Closes the file, if any.
+         */
+        ~PositionFileWriter();
+
+        PositionFileWriter(const PositionFileWriter&) = delete;
+        PositionFileWriter& operator=(const PositionFileWriter&) = delete;
+
+        /**
+         * @brief       Creates a position file, closing the previous one.
+         *
+         * @param[in]   path  The path of the file, which is overwritten if it exists.
+         *
+         * @return      True if the file was created, false otherwise.
+         */
+        bool Open(const std::string& path) noexcept;
+
+        /**
+         * @brief       Appends a position to the current game.
+         *
+         * @param[in]   board  The board holding the position.
+         *
+         * @return      True if the position was written, false otherwise.
+         */
+        bool Append(const BoardArea& board) noexcept;
+
+        /**
+         * @brief       Starts a new game, which the next positions belong to.
+         *
+         * Games without positions are left out of the index. Positions appended before the
+         * first game is started belong to a game of their own.
+         */
+        void StartGame(void) noexcept;
+
+        /**
+         * @brief       Writes the header and the index and closes the file.
+         *
+         * @return      True if the whole file was written, false otherwise.
+         */
+        bool Close(void) noexcept;
+
+    private:
+        std::FILE* file_;                         ///< The file being written.
+        std::uint64_t position_count_;            ///< The number of positions written.
+        std::vector<std::uint64_t> game_starts_;  ///< The first position of every game.
+        bool new_game_;                           ///< Whether the next position starts a game.
+        bool failed_;                             ///< Whether writing failed.
+    };
+}  // namespace raychess
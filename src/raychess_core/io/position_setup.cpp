@@ -0,0 +1,100 @@
+/**
+ * @file    position_setup.cpp
+ *
+ * @brief   Checks shared by everything that sets up a position piece by piece.
+ *
+ * @section DESCRIPTION
+ *
+ * Positions read from FEN strings or packed records are checked the same way, and their castling
+ * rights and en passant square are cleaned up the same way.
+ */
+
+#include "position_setup.hpp"
+
+#include "attacks.hpp"
+#include "bitboard.hpp"
+#include "move_generator.hpp"
+#include "pos2d.hpp"
+
+using namespace raychess;
+
+namespace
+{
+    /**
+     * @brief   The squares a king and a rook must stand on for a castling right.
+     */
+    struct CastlingSquares
+    {
+        std::uint8_t right;  ///< The castling right.
+        Piece king;          ///< The king of the right's side.
+        int king_square;     ///< The starting square of the king.
+        Piece rook;          ///< The rook of the right's side.
+        int rook_square;     ///< The starting square of the rook.
+    };
+
+    constexpr CastlingSquares kCastlingSquares[] = {
+        {BoardArea::WHITE_KING_SIDE, Piece::WHITE_KING, 4, Piece::WHITE_ROOK, 7},
+        {BoardArea::WHITE_QUEEN_SIDE, Piece::WHITE_KING, 4, Piece::WHITE_ROOK, 0},
+        {BoardArea::BLACK_KING_SIDE, Piece::BLACK_KING, 60, Piece::BLACK_ROOK, 63},
+        {BoardArea::BLACK_QUEEN_SIDE, Piece::BLACK_KING, 60, Piece::BLACK_ROOK, 56}};
+}  // namespace
+
+bool setup::IsPlacementValid(const BoardArea& board) noexcept
+{
+    const Bitboard white_king = board.GetPieceBitboard(PieceColour::WHITE, PieceType::KING);
+    const Bitboard black_king = board.GetPieceBitboard(PieceColour::BLACK, PieceType::KING);
+    const Bitboard pawns = board.GetPieceBitboard(PieceColour::WHITE, PieceType::PAWN) |
+                           board.GetPieceBitboard(PieceColour::BLACK, PieceType::PAWN);
+
+    return bitboard::PopCount(white_king) == 1 && bitboard::PopCount(black_king) == 1 &&
+           (pawns & (bitboard::kRank1 | bitboard::kRank8)) == bitboard::kEmpty;
+}
+
+bool setup::FinishPosition(BoardArea& board, std::uint8_t rights, int en_passant) noexcept
+{
+    if (!IsPlacementValid(board)) {
+        return false;
+    }
+
+    // The side which just moved cannot have left its king in check.
+    const PieceColour us = board.GetSideToMove();
+    const PieceColour them = OppositeColour(us);
+    const int king = bitboard::LsbIndex(board.GetPieceBitboard(them, PieceType::KING));
+    if ((MoveGenerator::GetAttackersTo(board, king, board.GetOccupiedBitboard()) &
+         board.GetColourBitboard(us)) != bitboard::kEmpty) {
+        return false;
+    }
+
+    if (en_passant != BoardArea::kNoSquare) {
+        const int rank = (us == PieceColour::WHITE ? 5 : 2);
+        if (en_passant < 0 || en_passant >= bitboard::kSquareCount ||
+            Position2D::FromSquareIndex(en_passant).y != rank) {
+            return false;
+        }
+
+        // The pawn pushed two squares stands in front of the en passant square, and both the
+        // square it passed and the one it came from are empty.
+        const int forward = (us == PieceColour::WHITE ? 8 : -8);
+        if (board.GetPiece(en_passant - forward) != MakePiece(them, PieceType::PAWN) ||
+            board.GetPiece(en_passant) != Piece::NONE ||
+            board.GetPiece(en_passant + forward) != Piece::NONE) {
+            return false;
+        }
+
+        if ((attacks::PawnAttacks(them, en_passant) &
+             board.GetPieceBitboard(us, PieceType::PAWN)) == bitboard::kEmpty) {
+            en_passant = BoardArea::kNoSquare;
+        }
+    }
+
+    for (const auto& squares : kCastlingSquares) {
+        if (board.GetPiece(squares.king_square) != squares.king ||
+            board.GetPiece(squares.rook_square) != squares.rook) {
+            rights &= ~squares.right;
+        }
+    }
+
+    board.SetCastlingRights(rights);
+    board.SetEnPassantSquare(en_passant);
+    return true;
+}
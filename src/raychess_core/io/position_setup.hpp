@@ -0,0 +1,51 @@
+/**
+ * @file    position_setup.hpp
+ *
+ * @brief   Checks shared by everything that sets up a position piece by piece.
+ *
+ * @section DESCRIPTION
+ *
+ * Positions read from FEN strings or packed records are checked the same way, and their castling
+ * rights and en passant square are cleaned up the same way, so that a position gets the same key
+ * whichever way it was stored.
+ */
+
+#pragma once
+
+#include <cstdint>
+
+#include "board_area.hpp"
+
+namespace raychess
+{
+    namespace setup
+    {
+        /**
+         * @brief       Checks that the pieces placed make up a position the engine can play from.
+         *
+         * @param[in]   board  The board holding the pieces.
+         *
+         * @return      True if each side has one king and no pawn is on the first or last rank.
+         */
+        bool IsPlacementValid(const BoardArea& board) noexcept;
+
+        /**
+         * @brief       Checks a position whose pieces and side to move are set, and sets its
+         * castling rights and en passant square.
+         *
+         * Castling rights whose king or rook is not on its starting square are dropped, as is an
+         * en passant square no pawn can capture onto, which is what BoardArea does after a move
+         * as well.
+         *
+         * @param[in,out]   board       The board holding the pieces, with the side to move set.
+         * @param[in]       rights      The castling rights stored with the position.
+         * @param[in]       en_passant  The en passant square stored with the position, or
+         * BoardArea::kNoSquare.
+         *
+         * @return      True if the placement is valid, the side not to move is not in check and
+         * the en passant square, if any, is the empty square behind a pawn the other side just
+         * pushed from an empty square, false otherwise. The board's state is only set on success.
+         */
+        bool FinishPosition(BoardArea& board, std::uint8_t rights, int en_passant) noexcept;
+    }  // namespace setup
+}  // namespace raychess
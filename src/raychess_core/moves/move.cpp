@@ -0,0 +1,32 @@
+/**
+ * @file    move.cpp
+ *
+ * @brief   A compact representation of a chess move.
+ *
+ * @section DESCRIPTION
+ *
+ * A move packed into 16 bits: the origin square, the target square and four bits of flags telling
+ * captures, promotions, castling, en passant and double pawn pushes apart.
+ */
+
+#include "move.hpp"
+
+using namespace raychess;
+
+std::string Move::ToString(void) const noexcept
+{
+    if (!IsValid()) {
+        return "0000";
+    }
+
+    const Position2D from = GetFromPosition();
+    const Position2D to = GetToPosition();
+    std::string text = {static_cast<char>('a' + from.x), static_cast<char>('1' + from.y),
+                        static_cast<char>('a' + to.x), static_cast<char>('1' + to.y)};
+
+    if (IsPromotion()) {
+        text += "pnbrqk"[static_cast<int>(GetPromotionType())];
+    }
+
+    return text;
+}
@@ -0,0 +1,244 @@
+/**
+ * @file    move.hpp
+ *
+ * @brief   A compact representation of a chess move.
+ *
+ * @section DESCRIPTION
+ *
+ * A move packed into 16 bits: the origin square, the target square and four bits of flags telling
+ * captures, promotions, castling, en passant and double pawn pushes apart.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+#include "bitboard.hpp"
+#include "piece_types.hpp"
+#include "pos2d.hpp"
+
+namespace raychess
+{
+    /**
+     * @brief   A compact representation of a chess move.
+     *
+     * The layout of the 16 bits is as follows:
+     *
+     * - bits 0-5: the origin square index
+     * - bits 6-11: the target square index
+     * - bits 12-15: the move flags, see Move::Flag
+     *
+     * The flag values are chosen so that the third bit marks captures and the fourth bit marks
+     * promotions, with the two lowest bits selecting the promotion piece.
+     *
+     * A default constructed move (A1 to A1, quiet) is never a valid move and is used to represent
+     * "no move".
+     */
+    class Move
+    {
+    public:
+        /**
+         * @brief       Structure representing the kind of a move.
+         */
+        enum class Flag : std::uint8_t
+        {
+            QUIET = 0,
+            DOUBLE_PAWN_PUSH = 1,
+            KING_CASTLE = 2,
+            QUEEN_CASTLE = 3,
+            CAPTURE = 4,
+            EN_PASSANT = 5,
+            KNIGHT_PROMOTION = 8,
+            BISHOP_PROMOTION = 9,
+            ROOK_PROMOTION = 10,
+            QUEEN_PROMOTION = 11,
+            KNIGHT_PROMOTION_CAPTURE = 12,
+            BISHOP_PROMOTION_CAPTURE = 13,
+            ROOK_PROMOTION_CAPTURE = 14,
+            QUEEN_PROMOTION_CAPTURE = 15
+        };
+
+        /**
+         * @brief       Default constructor. Initializes to "no move".
+         */
+        constexpr Move() noexcept : data_(0) {}
+
+        /**
+         * @brief       Constructor from the raw 16-bit encoding.
+         *
+         * @param[in]   raw  The raw encoding, as returned by GetRaw().
+         */
+        constexpr explicit Move(std::uint16_t raw) noexcept : data_(raw) {}
+
+        /**
+         * @brief       Constructor from square indices.
+         *
+         * @param[in]   from  The origin square index.
+         * @param[in]   to    The target square index.
+         * @param[in]   flag  The kind of the move.
+         */
+        constexpr Move(int from, int to, Flag flag = Flag::QUIET) noexcept
+            : data_(static_cast<std::uint16_t>(from | (to << 6) | (static_cast<int>(flag) << 12)))
+        {
+        }
+
+        /**
+         * @brief       Constructor from positions.
+         *
+         * @param[in]   from  The origin position.
+         * @param[in]   to    The target position.
+         * @param[in]   flag  The kind of the move.
+         */
+        Move(const Position2D& from, const Position2D& to, Flag flag = Flag::QUIET) noexcept
+            : Move(from.ToSquareIndex(), to.ToSquareIndex(), flag)
+        {
+        }
+
+        /**
+         * @brief       Origin square getter.
+         *
+         * @return      The index of the square the piece moves from.
+         */
+        constexpr int GetFrom(void) const noexcept { return data_ & 0x3f; }
+
+        /**
+         * @brief       Target square getter.
+         *
+         * @return      The index of the square the piece moves to.
+         */
+        constexpr int GetTo(void) const noexcept { return (data_ >> 6) & 0x3f; }
+
+        /**
+         * @brief       Origin position getter.
+         *
+         * @return      The position the piece moves from.
+         */
+        Position2D GetFromPosition(void) const noexcept
+        {
+            return Position2D::FromSquareIndex(GetFrom());
+        }
+
+        /**
+         * @brief       Target position getter.
+         *
+         * @return      The position the piece moves to.
+         */
+        Position2D GetToPosition(void) const noexcept
+        {
+            return Position2D::FromSquareIndex(GetTo());
+        }
+
+        /**
+         * @brief       Flag getter.
+         *
+         * @return      The kind of the move.
+         */
+        constexpr Flag GetFlag(void) const noexcept { return static_cast<Flag>(data_ >> 12); }
+
+        /**
+         * @brief       Checks whether the move captures a piece, en passant included.
+         *
+         * @return      True if the move is a capture, false otherwise.
+         */
+        constexpr bool IsCapture(void) const noexcept { return (data_ & 0x4000) != 0; }
+
+        /**
+         * @brief       Checks whether the move promotes a pawn.
+         *
+         * @return      True if the move is a promotion, false otherwise.
+         */
+        constexpr bool IsPromotion(void) const noexcept { return (data_ & 0x8000) != 0; }
+
+        /**
+         * @brief       Checks whether the move is a castling move, on either side.
+         *
+         * @return      True if the move is castling, false otherwise.
+         */
+        constexpr bool IsCastling(void) const noexcept
+        {
+            return GetFlag() == Flag::KING_CASTLE || GetFlag() == Flag::QUEEN_CASTLE;
+        }
+
+        /**
+         * @brief       Checks whether the move is an en passant capture.
+         *
+         * @return      True if the move is an en passant capture, false otherwise.
+         */
+        constexpr bool IsEnPassant(void) const noexcept { return GetFlag() == Flag::EN_PASSANT; }
+
+        /**
+         * @brief       Gets the type of the piece a pawn is promoted to.
+         *
+         * Only meaningful if the move is a promotion.
+         *
+         * @return      The type of the promoted piece.
+         */
+        constexpr PieceType GetPromotionType(void) const noexcept
+        {
+            return static_cast<PieceType>(static_cast<int>(PieceType::KNIGHT) +
+                                          ((data_ >> 12) & 0x3));
+        }
+
+        /**
+         * @brief       Gets the promotion flag for the given piece type.
+         *
+         * @param[in]   type     The type of the promoted piece, a knight, bishop, rook or queen.
+         * @param[in]   capture  Whether the promotion also captures a piece.
+         *
+         * @return      The flag of the promotion move.
+         */
+        static constexpr Flag PromotionFlag(PieceType type, bool capture) noexcept
+        {
+            return static_cast<Flag>(
+                static_cast<int>(Flag::KNIGHT_PROMOTION) +
+                (static_cast<int>(type) - static_cast<int>(PieceType::KNIGHT)) + (capture ? 4 : 0));
+        }
+
+        /**
+         * @brief       Converts the move to the long algebraic notation, as used by UCI.
+         *
+         * The notation is the origin square followed by the target square and, for promotions,
+         * the letter of the promotion piece, e.g. "e2e4" or "e7e8q". Castling is written as the
+         * king's move. "No move" is written as "0000".
+         *
+         * @return      The move in long algebraic notation.
+         */
+        std::string ToString(void) const noexcept;
+
+        /**
+         * @brief       Raw encoding getter.
+         *
+         * @return      The 16-bit encoding of the move.
+         */
+        constexpr std::uint16_t GetRaw(void) const noexcept { return data_; }
+
+        /**
+         * @brief       Checks whether the move is an actual move rather than "no move".
+         *
+         * @return      True if the move is not "no move", false otherwise.
+         */
+        constexpr bool IsValid(void) const noexcept { return data_ != 0; }
+
+        /**
+         * @brief       Compares this Move to another.
+         *
+         * @param[in]   rhs  The Move to compare to.
+         *
+         * @return      True if the two Moves are equal, false otherwise.
+         */
+        constexpr bool operator==(const Move& rhs) const noexcept { return data_ == rhs.data_; }
+
+        /**
+         * @brief       Compares this Move to another.
+         *
+         * @param[in]   rhs  The Move to compare to.
+         *
+         * @return      True if the two Moves are not equal, false otherwise.
+         */
+        constexpr bool operator!=(const Move& rhs) const noexcept { return data_ != rhs.data_; }
+
+    private:
+        std::uint16_t data_;  ///< The packed move.
+    };
+}  // namespace raychess
@@ -0,0 +1,539 @@
+/**
+ * @file    move_generator.cpp
+ *
+ * @brief   Generator of the legal moves of a position.
+ *
+ * @section DESCRIPTION
+ *
+ * The generator looks at the position once, finding the pieces giving check and the pieces pinned
+ * to their king, and uses that to emit only legal moves.
+ */
+
+#include "move_generator.hpp"
+
+#include <algorithm>
+#include <cstdint>
+
+#include "attacks.hpp"
+
+using namespace raychess;
+
+namespace
+{
+    /**
+     * @brief       Appends a move from one square to each of the target squares.
+     *
+     * @param[in]   from     The origin square index.
+     * @param[in]   targets  The target squares.
+     * @param[in]   enemies  The squares of the enemy pieces, moves to these are captures.
+     * @param[out]  moves    The list to append the moves to.
+     */
+    void AppendMoves(int from, Bitboard targets, Bitboard enemies, MoveList& moves) noexcept
+    {
+        while (targets != bitboard::kEmpty) {
+            const int to = bitboard::PopLsb(targets);
+
+            moves.PushBack(Move(from, to,
+                                bitboard::IsSet(enemies, to) ? Move::Flag::CAPTURE
+                                                             : Move::Flag::QUIET));
+        }
+    }
+
+    /**
+     * @brief       Appends a pawn move to each of the target squares, all made the same way.
+     *
+     * @tparam      offset  The distance from the origin square to the target square.
+     *
+     * @param[in]   targets  The target squares.
+     * @param[in]   flag     The flag of the moves.
+     * @param[out]  moves    The list to append the moves to.
+     */
+    template <int offset>
+    void AppendPawnMoves(Bitboard targets, Move::Flag flag, MoveList& moves) noexcept
+    {
+        while (targets != bitboard::kEmpty) {
+            const int to = bitboard::PopLsb(targets);
+
+            moves.PushBack(Move(to - offset, to, flag));
+        }
+    }
+
+    /**
+     * @brief       Appends the promotions of a pawn move to each of the target squares.
+     *
+     * @tparam      offset           The distance from the origin square to the target square.
+     * @tparam      queen            Whether to append the promotions to a queen.
+     * @tparam      underpromotions  Whether to append the promotions to the other pieces.
+     *
+     * @param[in]   targets  The target squares.
+     * @param[in]   capture  Whether the promotions also capture a piece.
+     * @param[out]  moves    The list to append the moves to.
+     */
+    template <int offset, bool queen, bool underpromotions>
+    void AppendPromotions(Bitboard targets, bool capture, MoveList& moves) noexcept
+    {
+        while (targets != bitboard::kEmpty) {
+            const int to = bitboard::PopLsb(targets);
+            const int from = to - offset;
+
+            if (queen) {
+                moves.PushBack(Move(from, to, Move::PromotionFlag(PieceType::QUEEN, capture)));
+            }
+            if (underpromotions) {
+                for (const auto type : {PieceType::ROOK, PieceType::BISHOP, PieceType::KNIGHT}) {
+                    moves.PushBack(Move(from, to, Move::PromotionFlag(type, capture)));
+                }
+            }
+        }
+    }
+
+    /**
+     * @brief       Gets the squares a piece attacks.
+     *
+     * @tparam      type  The type of the piece, a knight, bishop, rook or queen.
+     *
+     * @param[in]   square    The square index of the piece.
+     * @param[in]   occupied  The occupied squares, which stop the sliders.
+     *
+     * @return      A bitboard of the attacked squares.
+     */
+    template <PieceType type>
+    Bitboard PieceAttacks(int square, Bitboard occupied) noexcept
+    {
+        switch (type) {
+            case PieceType::KNIGHT:
+                return attacks::KnightAttacks(square);
+            case PieceType::BISHOP:
+                return attacks::BishopAttacks(square, occupied);
+            case PieceType::ROOK:
+                return attacks::RookAttacks(square, occupied);
+            default:
+                return attacks::QueenAttacks(square, occupied);
+        }
+    }
+}  // namespace
+
+MoveGenerator::MoveGenerator(const BoardArea& board) noexcept
+    : board_(board),
+      us_(board.GetSideToMove()),
+      them_(OppositeColour(us_)),
+      king_square_(BoardArea::kNoSquare),
+      own_(board.GetColourBitboard(us_)),
+      enemies_(board.GetColourBitboard(them_)),
+      occupied_(board.GetOccupiedBitboard()),
+      checkers_(bitboard::kEmpty),
+      pinned_(bitboard::kEmpty)
+{
+    const Bitboard king = board.GetPieceBitboard(us_, PieceType::KING);
+
+    // Without a king there is nothing to keep safe, every pseudo-legal move is legal.
+    if (king == bitboard::kEmpty) {
+        return;
+    }
+    king_square_ = bitboard::LsbIndex(king);
+    checkers_ = GetAttackersTo(board, king_square_, occupied_) & enemies_;
+
+    // Enemy sliders which would attack the king if it weren't for the pieces in between pin the
+    // piece between them, if there is exactly one and it is ours.
+    const Bitboard queens = board.GetPieceBitboard(them_, PieceType::QUEEN);
+    Bitboard snipers =
+        (attacks::RookAttacks(king_square_, enemies_) &
+         (board.GetPieceBitboard(them_, PieceType::ROOK) | queens)) |
+        (attacks::BishopAttacks(king_square_, enemies_) &
+         (board.GetPieceBitboard(them_, PieceType::BISHOP) | queens));
+
+    while (snipers != bitboard::kEmpty) {
+        const Bitboard blockers = attacks::Between(king_square_, bitboard::PopLsb(snipers)) &
+                                  occupied_;
+
+        if (bitboard::PopCount(blockers) == 1) {
+            pinned_ |= blockers & own_;
+        }
+    }
+}
+
+template <MoveGenerator::Mode mode>
+void MoveGenerator::GenerateMoves(MoveList& moves) const noexcept
+{
+    if (us_ == PieceColour::WHITE) {
+        Generate<PieceColour::WHITE, mode>(moves);
+    }
+    else {
+        Generate<PieceColour::BLACK, mode>(moves);
+    }
+}
+
+bool MoveGenerator::IsLegal(Move move) const noexcept
+{
+    const int from = move.GetFrom();
+    const int to = move.GetTo();
+
+    if (!move.IsValid() || !bitboard::IsSet(own_, from) ||
+        !bitboard::IsSet(board_.GetBoardMask() & ~own_, to)) {
+        return false;
+    }
+
+    // The two flags between en passant and the promotions aren't used by any move.
+    if (move.IsCapture() && !move.IsPromotion() && move.GetFlag() != Move::Flag::CAPTURE &&
+        !move.IsEnPassant()) {
+        return false;
+    }
+
+    const PieceType type = GetPieceType(board_.GetPiece(from));
+
+    // Castling and en passant are rare enough for their own generators to settle them.
+    if (move.IsCastling() || move.IsEnPassant()) {
+        MoveList moves;
+        if (move.IsCastling() && type == PieceType::KING && !IsInCheck()) {
+            if (us_ == PieceColour::WHITE) {
+                GenerateCastlingMoves<PieceColour::WHITE>(moves);
+            }
+            else {
+                GenerateCastlingMoves<PieceColour::BLACK>(moves);
+            }
+        }
+        else if (move.IsEnPassant() && type == PieceType::PAWN) {
+            if (us_ == PieceColour::WHITE) {
+                GenerateEnPassantMoves<PieceColour::WHITE>(moves);
+            }
+            else {
+                GenerateEnPassantMoves<PieceColour::BLACK>(moves);
+            }
+        }
+        return std::find(moves.begin(), moves.end(), move) != moves.end();
+    }
+
+    if (move.IsCapture() != bitboard::IsSet(enemies_, to)) {
+        return false;
+    }
+
+    if (type == PieceType::PAWN) {
+        const bool white = us_ == PieceColour::WHITE;
+        const int forward = white ? bitboard::kBoardSize : -bitboard::kBoardSize;
+        const int last_rank = white ? board_.GetDimensionY() - 1 : 0;
+        const int start_rank = white ? 1 : board_.GetDimensionY() - 2;
+
+        if (move.IsPromotion() != (to / bitboard::kBoardSize == last_rank)) {
+            return false;
+        }
+        if (move.IsCapture()) {
+            if (!bitboard::IsSet(attacks::PawnAttacks(us_, from), to)) {
+                return false;
+            }
+        }
+        else if (move.GetFlag() == Move::Flag::DOUBLE_PAWN_PUSH) {
+            if (from / bitboard::kBoardSize != start_rank || to != from + 2 * forward ||
+                bitboard::IsSet(occupied_, from + forward)) {
+                return false;
+            }
+        }
+        else if (to != from + forward) {
+            return false;
+        }
+    }
+    else {
+        if (move.IsPromotion() || move.GetFlag() == Move::Flag::DOUBLE_PAWN_PUSH) {
+            return false;
+        }
+
+        switch (type) {
+            case PieceType::KNIGHT:
+                return bitboard::IsSet(attacks::KnightAttacks(from), to) && IsFreeToMove(from, to);
+            case PieceType::BISHOP:
+                return bitboard::IsSet(attacks::BishopAttacks(from, occupied_), to) &&
+                       IsFreeToMove(from, to);
+            case PieceType::ROOK:
+                return bitboard::IsSet(attacks::RookAttacks(from, occupied_), to) &&
+                       IsFreeToMove(from, to);
+            case PieceType::QUEEN:
+                return bitboard::IsSet(attacks::QueenAttacks(from, occupied_), to) &&
+                       IsFreeToMove(from, to);
+            default:
+                // The king is taken off the board, so that it can't hide behind itself.
+                return bitboard::IsSet(attacks::KingAttacks(from), to) &&
+                       !IsSquareAttacked(board_, to, them_,
+                                         occupied_ & ~bitboard::SquareBit(from));
+        }
+    }
+
+    return IsFreeToMove(from, to);
+}
+
+Bitboard MoveGenerator::GetAttackersTo(const BoardArea& board, int square,
+                                       Bitboard occupied) noexcept
+{
+    const Bitboard queens = board.GetPieceBitboard(PieceColour::WHITE, PieceType::QUEEN) |
+                            board.GetPieceBitboard(PieceColour::BLACK, PieceType::QUEEN);
+    const Bitboard rooks = board.GetPieceBitboard(PieceColour::WHITE, PieceType::ROOK) |
+                           board.GetPieceBitboard(PieceColour::BLACK, PieceType::ROOK);
+    const Bitboard bishops = board.GetPieceBitboard(PieceColour::WHITE, PieceType::BISHOP) |
+                             board.GetPieceBitboard(PieceColour::BLACK, PieceType::BISHOP);
+    const Bitboard knights = board.GetPieceBitboard(PieceColour::WHITE, PieceType::KNIGHT) |
+                             board.GetPieceBitboard(PieceColour::BLACK, PieceType::KNIGHT);
+    const Bitboard kings = board.GetPieceBitboard(PieceColour::WHITE, PieceType::KING) |
+                           board.GetPieceBitboard(PieceColour::BLACK, PieceType::KING);
+
+    // A pawn attacks the square if a pawn of the opposite colour on the square would attack it.
+    return (attacks::PawnAttacks(PieceColour::BLACK, square) &
+            board.GetPieceBitboard(PieceColour::WHITE, PieceType::PAWN)) |
+           (attacks::PawnAttacks(PieceColour::WHITE, square) &
+            board.GetPieceBitboard(PieceColour::BLACK, PieceType::PAWN)) |
+           (attacks::KnightAttacks(square) & knights) | (attacks::KingAttacks(square) & kings) |
+           (attacks::RookAttacks(square, occupied) & (rooks | queens)) |
+           (attacks::BishopAttacks(square, occupied) & (bishops | queens));
+}
+
+bool MoveGenerator::IsSquareAttacked(const BoardArea& board, int square, PieceColour colour,
+                                     Bitboard occupied) noexcept
+{
+    return (GetAttackersTo(board, square, occupied) & board.GetColourBitboard(colour)) !=
+           bitboard::kEmpty;
+}
+
+template <PieceColour us, MoveGenerator::Mode mode>
+void MoveGenerator::Generate(MoveList& moves) const noexcept
+{
+    const Bitboard empty = ~occupied_ & board_.GetBoardMask();
+    const Bitboard targets = (mode == Mode::CAPTURES ? enemies_
+                              : mode == Mode::QUIETS ? empty
+                                                     : enemies_ | empty);
+
+    if (king_square_ != BoardArea::kNoSquare) {
+        GenerateKingMoves(targets, moves);
+
+        // In double check only the king can move.
+        if (bitboard::PopCount(checkers_) > 1) {
+            return;
+        }
+    }
+
+    // Out of a single check, the other pieces have to capture the checker or step in between.
+    Bitboard check_mask = bitboard::kFull;
+    if (IsInCheck()) {
+        const int checker = bitboard::LsbIndex(checkers_);
+        check_mask = attacks::Between(king_square_, checker) | checkers_;
+    }
+    else if (king_square_ != BoardArea::kNoSquare && (mode == Mode::QUIETS || mode == Mode::ALL)) {
+        GenerateCastlingMoves<us>(moves);
+    }
+
+    GeneratePieceMoves<PieceType::KNIGHT>(targets & check_mask, moves);
+    GeneratePieceMoves<PieceType::BISHOP>(targets & check_mask, moves);
+    GeneratePieceMoves<PieceType::ROOK>(targets & check_mask, moves);
+    GeneratePieceMoves<PieceType::QUEEN>(targets & check_mask, moves);
+
+    // The pawns which aren't pinned all move the same way, pinned pawns only along their pin.
+    const Bitboard pawns = board_.GetPieceBitboard(us, PieceType::PAWN);
+    GeneratePawnMoves<us, mode>(pawns & ~pinned_, check_mask, moves);
+
+    Bitboard pinned_pawns = pawns & pinned_;
+    while (pinned_pawns != bitboard::kEmpty) {
+        const int from = bitboard::PopLsb(pinned_pawns);
+        GeneratePawnMoves<us, mode>(bitboard::SquareBit(from),
+                                    check_mask & attacks::Line(king_square_, from), moves);
+    }
+
+    if (mode != Mode::QUIETS) {
+        GenerateEnPassantMoves<us>(moves);
+    }
+}
+
+void MoveGenerator::GenerateKingMoves(Bitboard targets, MoveList& moves) const noexcept
+{
+    // The king is taken off the board, so that it can't hide behind itself from a slider.
+    const Bitboard occupied = occupied_ & ~bitboard::SquareBit(king_square_);
+    targets &= attacks::KingAttacks(king_square_);
+
+    while (targets != bitboard::kEmpty) {
+        const int to = bitboard::PopLsb(targets);
+
+        if (!IsSquareAttacked(board_, to, them_, occupied)) {
+            moves.PushBack(Move(king_square_, to,
+                                bitboard::IsSet(enemies_, to) ? Move::Flag::CAPTURE
+                                                              : Move::Flag::QUIET));
+        }
+    }
+}
+
+template <PieceColour us>
+void MoveGenerator::GenerateCastlingMoves(MoveList& moves) const noexcept
+{
+    constexpr bool white = us == PieceColour::WHITE;
+    constexpr std::uint8_t king_side_right =
+        white ? BoardArea::WHITE_KING_SIDE : BoardArea::BLACK_KING_SIDE;
+    constexpr std::uint8_t queen_side_right =
+        white ? BoardArea::WHITE_QUEEN_SIDE : BoardArea::BLACK_QUEEN_SIDE;
+    const std::uint8_t rights =
+        board_.GetCastlingRights() & (king_side_right | queen_side_right);
+
+    if (rights == BoardArea::NO_CASTLING) {
+        return;
+    }
+
+    const int rank = king_square_ - king_square_ % bitboard::kBoardSize;
+    const Bitboard rooks = board_.GetPieceBitboard(us, PieceType::ROOK);
+
+    for (const bool king_side : {true, false}) {
+        const std::uint8_t right = king_side ? king_side_right : queen_side_right;
+        const int rook = rank + (king_side ? board_.GetDimensionX() - 1 : 0);
+        const int to = rank + (king_side ? 6 : 2);
+        const int rook_to = king_side ? to - 1 : to + 1;
+
+        if ((rights & right) == 0 || !bitboard::IsSet(rooks, rook)) {
+            continue;
+        }
+
+        // Everything between the king and the rook and both their target squares must be empty,
+        // apart from the king and the rook themselves.
+        const Bitboard castlers = bitboard::SquareBit(king_square_) | bitboard::SquareBit(rook);
+        const Bitboard path = attacks::Between(king_square_, rook) | bitboard::SquareBit(to) |
+                              bitboard::SquareBit(rook_to);
+        if ((path & occupied_ & ~castlers) != bitboard::kEmpty) {
+            continue;
+        }
+
+        // The king may not pass through or land on an attacked square. It's not in check, so its
+        // own square is safe already.
+        Bitboard king_path = attacks::Between(king_square_, to) | bitboard::SquareBit(to);
+        bool safe = true;
+        while (safe && king_path != bitboard::kEmpty) {
+            safe = !IsSquareAttacked(board_, bitboard::PopLsb(king_path), them_, occupied_);
+        }
+
+        if (safe) {
+            moves.PushBack(Move(king_square_, to,
+                                king_side ? Move::Flag::KING_CASTLE : Move::Flag::QUEEN_CASTLE));
+        }
+    }
+}
+
+template <PieceType type>
+void MoveGenerator::GeneratePieceMoves(Bitboard targets, MoveList& moves) const noexcept
+{
+    Bitboard pieces = board_.GetPieceBitboard(us_, type);
+
+    while (pieces != bitboard::kEmpty) {
+        const int from = bitboard::PopLsb(pieces);
+
+        AppendMoves(from, PieceAttacks<type>(from, occupied_) & targets & GetPinMask(from),
+                    enemies_, moves);
+    }
+}
+
+template <PieceColour us, MoveGenerator::Mode mode>
+void MoveGenerator::GeneratePawnMoves(Bitboard pawns, Bitboard targets,
+                                      MoveList& moves) const noexcept
+{
+    constexpr bool white = us == PieceColour::WHITE;
+    constexpr int up = white ? bitboard::kBoardSize : -bitboard::kBoardSize;
+    constexpr int up_left = up - 1;
+    constexpr int up_right = up + 1;
+
+    // The board may be smaller than the bitboard, so the ranks of black's pawns depend on it.
+    const Bitboard last_rank = bitboard::RankMask(white ? board_.GetDimensionY() - 1 : 0);
+    const Bitboard third_rank = bitboard::RankMask(white ? 2 : board_.GetDimensionY() - 3);
+    const Bitboard empty = ~occupied_ & board_.GetBoardMask();
+    const Bitboard promoting = pawns & bitboard::Shift<-up>(last_rank);
+    const Bitboard others = pawns & ~promoting;
+
+    if (mode != Mode::CAPTURES) {
+        // Only pawns which could still push once from the third rank came from the second.
+        const Bitboard single = bitboard::Shift<up>(others) & empty;
+        const Bitboard double_push = bitboard::Shift<up>(single & third_rank) & empty & targets;
+
+        AppendPawnMoves<up>(single & targets, Move::Flag::QUIET, moves);
+        AppendPawnMoves<up + up>(double_push, Move::Flag::DOUBLE_PAWN_PUSH, moves);
+    }
+
+    if (mode != Mode::QUIETS) {
+        const Bitboard captures = enemies_ & targets;
+
+        AppendPawnMoves<up_left>(bitboard::Shift<up_left>(others & ~bitboard::kFileA) & captures,
+                                 Move::Flag::CAPTURE, moves);
+        AppendPawnMoves<up_right>(bitboard::Shift<up_right>(others & ~bitboard::kFileH) & captures,
+                                  Move::Flag::CAPTURE, moves);
+    }
+
+    if (promoting != bitboard::kEmpty) {
+        constexpr bool queen = mode != Mode::QUIETS;
+        constexpr bool underpromotions = mode != Mode::CAPTURES;
+        const Bitboard captures = enemies_ & targets;
+
+        AppendPromotions<up, queen, underpromotions>(
+            bitboard::Shift<up>(promoting) & empty & targets, false, moves);
+        if (mode != Mode::QUIETS) {
+            AppendPromotions<up_left, true, true>(
+                bitboard::Shift<up_left>(promoting & ~bitboard::kFileA) & captures, true, moves);
+            AppendPromotions<up_right, true, true>(
+                bitboard::Shift<up_right>(promoting & ~bitboard::kFileH) & captures, true, moves);
+        }
+    }
+}
+
+template <PieceColour us>
+void MoveGenerator::GenerateEnPassantMoves(MoveList& moves) const noexcept
+{
+    constexpr int up = us == PieceColour::WHITE ? bitboard::kBoardSize : -bitboard::kBoardSize;
+    const int target = board_.GetEnPassantSquare();
+
+    if (target == BoardArea::kNoSquare) {
+        return;
+    }
+
+    const int captured = target - up;
+    Bitboard pawns = attacks::PawnAttacks(OppositeColour(us), target) &
+                     board_.GetPieceBitboard(us, PieceType::PAWN);
+
+    while (pawns != bitboard::kEmpty) {
+        const int from = bitboard::PopLsb(pawns);
+
+        // En passant removes two pieces from the same rank, which a pin check can't see, so the
+        // king's safety is checked on the board as it is after the capture.
+        if (king_square_ != BoardArea::kNoSquare) {
+            const Bitboard occupied = (occupied_ ^ bitboard::SquareBit(from) ^
+                                       bitboard::SquareBit(captured)) |
+                                      bitboard::SquareBit(target);
+            const Bitboard attackers = GetAttackersTo(board_, king_square_, occupied) & enemies_ &
+                                       ~bitboard::SquareBit(captured);
+
+            if (attackers != bitboard::kEmpty) {
+                continue;
+            }
+        }
+
+        moves.PushBack(Move(from, target, Move::Flag::EN_PASSANT));
+    }
+}
+
+bool MoveGenerator::IsFreeToMove(int from, int to) const noexcept
+{
+    if (king_square_ != BoardArea::kNoSquare && IsInCheck()) {
+        // In double check only the king can move, in single check the others have to capture
+        // the checker or step in between.
+        if (bitboard::PopCount(checkers_) > 1 ||
+            !bitboard::IsSet(attacks::Between(king_square_, bitboard::LsbIndex(checkers_)) |
+                                 checkers_,
+                             to)) {
+            return false;
+        }
+    }
+
+    return bitboard::IsSet(GetPinMask(from), to);
+}
+
+Bitboard MoveGenerator::GetPinMask(int square) const noexcept
+{
+    if (!bitboard::IsSet(pinned_, square)) {
+        return bitboard::kFull;
+    }
+    return attacks::Line(king_square_, square);
+}
+
+template void MoveGenerator::GenerateMoves<MoveGenerator::Mode::CAPTURES>(
+    MoveList& moves) const noexcept;
+template void MoveGenerator::GenerateMoves<MoveGenerator::Mode::QUIETS>(
+    MoveList& moves) const noexcept;
+template void MoveGenerator::GenerateMoves<MoveGenerator::Mode::EVASIONS>(
+    MoveList& moves) const noexcept;
+template void MoveGenerator::GenerateMoves<MoveGenerator::Mode::ALL>(
+    MoveList& moves) const noexcept;
@@ -0,0 +1,230 @@
+/**
+ * @file    move_generator.hpp
+ *
+ * @brief   Generator of the legal moves of a position.
+ *
+ * @section DESCRIPTION
+ *
+ * The generator looks at the position once, finding the pieces giving check and the pieces pinned
+ * to their king, and uses that to emit only legal moves, so a move never has to be made just to
+ * find out whether it leaves the king in check.
+ *
+ * The generation is specialised at compile time for the side to move and each piece type, so that
+ * directions, pawn push offsets and castling rights are constants and the branches on them go
+ * away. It can also be limited to some of the moves, such as the captures the quiescence search
+ * looks at.
+ */
+
+#pragma once
+
+#include "bitboard.hpp"
+#include "board_area.hpp"
+#include "move_list.hpp"
+#include "piece_types.hpp"
+
+namespace raychess
+{
+    /**
+     * @brief   Generator of the legal moves of the side to move.
+     *
+     * The generator keeps a reference to the board, the board must not change while the
+     * generator is in use.
+     */
+    class MoveGenerator
+    {
+    public:
+        /**
+         * @brief   The kinds of moves to generate.
+         */
+        enum class Mode
+        {
+            CAPTURES,  ///< Captures, and pawn pushes promoting to a queen.
+            QUIETS,    ///< All other moves, castling and pawn pushes underpromoting included.
+            EVASIONS,  ///< All moves, when the side to move is in check.
+            ALL        ///< All moves.
+        };
+
+        /**
+         * @brief       Constructor. Finds the checkers and the pinned pieces of the position.
+         *
+         * @param[in]   board  The board to generate the moves for.
+         */
+        explicit MoveGenerator(const BoardArea& board) noexcept;
+
+        /**
+         * @brief       Appends all legal moves of the side to move to a move list.
+         *
+         * Castling, en passant and all four promotions are included.
+         *
+         * @param[out]  moves  The list to append the moves to.
+         */
+        void GenerateMoves(MoveList& moves) const noexcept { GenerateMoves<Mode::ALL>(moves); }
+
+        /**
+         * @brief       Appends the legal moves of the given kind to a move list.
+         *
+         * The captures and the quiets together are all the moves, in no particular order.
+         *
+         * @tparam      mode  The kind of moves to generate.
+         *
+         * @param[out]  moves  The list to append the moves to.
+         */
+        template <Mode mode>
+        void GenerateMoves(MoveList& moves) const noexcept;
+
+        /**
+         * @brief       Checks whether a move is legal in the position.
+         *
+         * Meant for moves which come from elsewhere, such as the transposition table or killer
+         * moves of another position, which saves generating all moves just to look for them.
+         *
+         * @param[in]   move  The move to check, "no move" included.
+         *
+         * @return      True if GenerateMoves() would generate the move, false otherwise.
+         */
+        bool IsLegal(Move move) const noexcept;
+
+        /**
+         * @brief       Checkers getter.
+         *
+         * @return      A bitboard of the enemy pieces giving check to the side to move.
+         */
+        Bitboard GetCheckers(void) const noexcept { return checkers_; }
+
+        /**
+         * @brief       Pinned pieces getter.
+         *
+         * @return      A bitboard of the pieces of the side to move which are pinned to their king.
+         */
+        Bitboard GetPinned(void) const noexcept { return pinned_; }
+
+        /**
+         * @brief       Checks whether the side to move is in check.
+         *
+         * @return      True if the king of the side to move is attacked, false otherwise.
+         */
+        bool IsInCheck(void) const noexcept { return checkers_ != bitboard::kEmpty; }
+
+        /**
+         * @brief       Gets the pieces of both colours attacking a square.
+         *
+         * @param[in]   board     The board the pieces are on.
+         * @param[in]   square    The square index.
+         * @param[in]   occupied  The occupied squares to use for the sliders.
+         *
+         * @return      A bitboard of the attacking pieces.
+         */
+        static Bitboard GetAttackersTo(const BoardArea& board, int square,
+                                       Bitboard occupied) noexcept;
+
+        /**
+         * @brief       Checks whether a square is attacked by pieces of the given colour.
+         *
+         * @param[in]   board     The board the pieces are on.
+         * @param[in]   square    The square index.
+         * @param[in]   colour    The colour of the attacking pieces.
+         * @param[in]   occupied  The occupied squares to use for the sliders.
+         *
+         * @return      True if the square is attacked, false otherwise.
+         */
+        static bool IsSquareAttacked(const BoardArea& board, int square, PieceColour colour,
+                                     Bitboard occupied) noexcept;
+
+    private:
+        /**
+         * @brief       Appends the legal moves of the given kind, for one side to move.
+         *
+         * @tparam      us    The colour of the side to move.
+         * @tparam      mode  The kind of moves to generate.
+         *
+         * @param[out]  moves  The list to append the moves to.
+         */
+        template <PieceColour us, Mode mode>
+        void Generate(MoveList& moves) const noexcept;
+
+        /**
+         * @brief       Appends the legal moves of the king, castling excluded.
+         *
+         * @param[in]   targets  The squares the king may move to, safe or not.
+         * @param[out]  moves    The list to append the moves to.
+         */
+        void GenerateKingMoves(Bitboard targets, MoveList& moves) const noexcept;
+
+        /**
+         * @brief       Appends the legal castling moves.
+         *
+         * @tparam      us  The colour of the side to move.
+         *
+         * @param[out]  moves  The list to append the moves to.
+         */
+        template <PieceColour us>
+        void GenerateCastlingMoves(MoveList& moves) const noexcept;
+
+        /**
+         * @brief       Appends the legal moves of the pieces of one type.
+         *
+         * @tparam      type  The type of the pieces, a knight, bishop, rook or queen.
+         *
+         * @param[in]   targets  The squares the pieces may move to.
+         * @param[out]  moves    The list to append the moves to.
+         */
+        template <PieceType type>
+        void GeneratePieceMoves(Bitboard targets, MoveList& moves) const noexcept;
+
+        /**
+         * @brief       Appends the moves of some pawns, all at once, en passant excluded.
+         *
+         * The pawns must be free to move to all of the given squares, so pinned pawns are passed
+         * one at a time along with their pin line.
+         *
+         * @tparam      us    The colour of the pawns.
+         * @tparam      mode  The kind of moves to generate.
+         *
+         * @param[in]   pawns    The pawns to move.
+         * @param[in]   targets  The squares the pawns may move (or capture) to.
+         * @param[out]  moves    The list to append the moves to.
+         */
+        template <PieceColour us, Mode mode>
+        void GeneratePawnMoves(Bitboard pawns, Bitboard targets, MoveList& moves) const noexcept;
+
+        /**
+         * @brief       Appends the legal en passant captures.
+         *
+         * @tparam      us  The colour of the side to move.
+         *
+         * @param[out]  moves  The list to append the moves to.
+         */
+        template <PieceColour us>
+        void GenerateEnPassantMoves(MoveList& moves) const noexcept;
+
+        /**
+         * @brief       Checks whether a piece other than the king may move to a square it reaches.
+         *
+         * @param[in]   from  The square index of the piece.
+         * @param[in]   to    The square index to move to.
+         *
+         * @return      True if the move neither ignores a check nor breaks a pin, false otherwise.
+         */
+        bool IsFreeToMove(int from, int to) const noexcept;
+
+        /**
+         * @brief       Gets the squares a piece may move along without exposing its king.
+         *
+         * @param[in]   square  The square index of the piece.
+         *
+         * @return      The line through the king and the piece if it's pinned, all squares
+         * otherwise.
+         */
+        Bitboard GetPinMask(int square) const noexcept;
+
+        const BoardArea& board_;  ///< The board to generate the moves for.
+        PieceColour us_;          ///< The colour of the side to move.
+        PieceColour them_;        ///< The colour of the other side.
+        int king_square_;         ///< Square of the side to move's king, or BoardArea::kNoSquare.
+        Bitboard own_;            ///< Squares of the side to move's pieces.
+        Bitboard enemies_;        ///< Squares of the other side's pieces.
+        Bitboard occupied_;       ///< Squares of all pieces.
+        Bitboard checkers_;       ///< Enemy pieces giving check.
+        Bitboard pinned_;         ///< Own pieces pinned to the king.
+    };
+}  // namespace raychess
@@ -0,0 +1,32 @@
+/**
+ * @file    move_list.hpp
+ *
+ * @brief   A list of moves for the move generators to append to.
+ *
+ * @section DESCRIPTION
+ *
+ * Move generation appends into a caller supplied list living on the stack instead of returning a
+ * freshly allocated vector, so generating moves performs no heap allocations at all.
+ */
+
+#pragma once
+
+#include <cstddef>
+
+#include "fixed_list.hpp"
+#include "move.hpp"
+
+namespace raychess
+{
+    /**
+     * @brief   The maximum number of moves a move list can hold.
+     *
+     * No legal chess position has more than 218 moves, so 256 leaves some headroom.
+     */
+    constexpr std::size_t kMaxMoves = 256;
+
+    /**
+     * @brief   A fixed capacity list of moves, see FixedList.
+     */
+    using MoveList = FixedList<Move, kMaxMoves>;
+}  // namespace raychess
@@ -0,0 +1,141 @@
+/**
+ * @file    perft.cpp
+ *
+ * @brief   Performance test of the move generation.
+ *
+ * @section DESCRIPTION
+ *
+ * Perft walks the tree of all legal moves to a fixed depth and counts its leaves.
+ */
+
+#include "perft.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <thread>
+
+#include "move_generator.hpp"
+#include "move_list.hpp"
+#include "piece_square_tables.hpp"
+#include "zobrist.hpp"
+
+using namespace raychess;
+
+namespace
+{
+    /**
+     * @brief       Checks the state a board keeps up to date against the state computed from
+     * scratch.
+     *
+     * @param[in]   board  The board to check.
+     *
+     * @return      True if the keys, the scores and the phase all match, false otherwise.
+     */
+    bool IsStateConsistent(const BoardArea& board) noexcept
+    {
+        int middlegame;
+        int endgame;
+        int phase;
+        psqt::ComputeScores(board, middlegame, endgame, phase);
+
+        return board.GetKey() == zobrist::ComputeKey(board) &&
+               board.GetPawnKey() == zobrist::ComputePawnKey(board) &&
+               board.GetMiddlegameScore() == middlegame && board.GetEndgameScore() == endgame &&
+               board.GetPhase() == phase;
+    }
+}  // namespace
+
+std::uint64_t perft::CountNodes(BoardArea& board, int depth, PerftHash* hash) noexcept
+{
+    if (depth <= 0) {
+        return 1;
+    }
+
+    MoveList moves;
+    MoveGenerator(board).GenerateMoves(moves);
+
+    // The generated moves are all legal, so the last ply needn't be made to be counted.
+    if (depth == 1) {
+        return moves.Size();
+    }
+
+    std::uint64_t key = 0;
+    std::uint64_t nodes = 0;
+    if (hash != nullptr) {
+        key = board.GetKey();
+        if (hash->Probe(key, depth, nodes)) {
+            return nodes;
+        }
+    }
+
+    for (const Move move : moves) {
+        BoardArea::UndoRecord undo;
+
+        board.MakeMove(move, undo);
+        nodes += CountNodes(board, depth - 1, hash);
+        board.UnmakeMove(undo);
+    }
+
+    if (hash != nullptr) {
+        hash->Store(key, depth, nodes);
+    }
+
+    return nodes;
+}
+
+std::uint64_t perft::CountMismatches(BoardArea& board, int depth) noexcept
+{
+    if (depth <= 0) {
+        return 0;
+    }
+
+    MoveList moves;
+    MoveGenerator(board).GenerateMoves(moves);
+
+    std::uint64_t mismatches = 0;
+    for (const Move move : moves) {
+        BoardArea::UndoRecord undo;
+
+        board.MakeMove(move, undo);
+        mismatches += IsStateConsistent(board) ? 0 : 1;
+        mismatches += CountMismatches(board, depth - 1);
+        board.UnmakeMove(undo);
+        mismatches += IsStateConsistent(board) ? 0 : 1;
+    }
+
+    return mismatches;
+}
+
+std::vector<perft::DivideEntry> perft::Divide(const BoardArea& board, int depth,
+                                              unsigned int thread_count, PerftHash* hash) noexcept
+{
+    MoveList moves;
+    MoveGenerator(board).GenerateMoves(moves);
+
+    std::vector<DivideEntry> entries(moves.Size());
+    std::atomic<std::size_t> next_move(0);
+
+    const auto count_root_moves = [&]() {
+        BoardArea local_board(board);
+
+        for (std::size_t i = next_move++; i < moves.Size(); i = next_move++) {
+            BoardArea::UndoRecord undo;
+
+            local_board.MakeMove(moves[i], undo);
+            entries[i] = {moves[i], CountNodes(local_board, depth - 1, hash)};
+            local_board.UnmakeMove(undo);
+        }
+    };
+
+    // The calling thread counts too, so only the remaining threads need to be started.
+    std::vector<std::thread> helpers;
+    for (unsigned int i = 1; i < thread_count && i < moves.Size(); i++) {
+        helpers.emplace_back(count_root_moves);
+    }
+    count_root_moves();
+    for (auto& helper : helpers) {
+        helper.join();
+    }
+
+    return entries;
+}
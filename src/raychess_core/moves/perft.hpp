@@ -0,0 +1,86 @@
+/**
+ * @file    perft.hpp
+ *
+ * @brief   Performance test of the move generation.
+ *
+ * @section DESCRIPTION
+ *
+ * Perft walks the tree of all legal moves to a fixed depth and counts its leaves. The counts of
+ * many positions are well known, which makes perft the standard way to check that a move
+ * generator (and making and unmaking moves) is correct, and a good way to measure its speed.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "board_area.hpp"
+#include "move.hpp"
+#include "perft_hash.hpp"
+
+namespace raychess
+{
+    namespace perft
+    {
+        /**
+         * @brief   The number of leaves below a single root move.
+         */
+        struct DivideEntry
+        {
+            Move move;            ///< The root move.
+            std::uint64_t nodes;  ///< Number of leaves below the move.
+        };
+
+        /**
+         * @brief       Counts the leaves of the legal move tree of the given depth.
+         *
+         * The board is restored to its original state before returning.
+         *
+         * @param[in,out]   board  The position to count the leaves of.
+         * @param[in]       depth  The depth of the tree, in plies.
+         * @param[in,out]   hash   The hash table to look up and store the counts of subtrees in,
+         * or nullptr to count every subtree.
+         *
+         * @return      The number of leaves.
+         */
+        std::uint64_t CountNodes(BoardArea& board, int depth, PerftHash* hash = nullptr) noexcept;
+
+        /**
+         * @brief       Checks the state BoardArea keeps up to date against the same state computed
+         * from scratch, all over the legal move tree of the given depth.
+         *
+         * The Zobrist key, the pawn key, the piece-square scores and the phase are compared after
+         * every move made and unmade, the moves of the last ply included, so this is far slower
+         * than CountNodes(). The board is restored to its original state before returning.
+         *
+         * @param[in,out]   board  The position to check the tree of.
+         * @param[in]       depth  The depth of the tree, in plies.
+         *
+         * @return      The number of times the state differed, 0 if it always matched.
+         */
+        std::uint64_t CountMismatches(BoardArea& board, int depth) noexcept;
+
+        /**
+         * @brief       Counts the leaves of the legal move tree below each root move separately.
+         *
+         * Comparing the per-move counts to those of another move generator narrows down the
+         * move a difference comes from.
+         *
+         * The root moves are split between the given number of threads, each counting on its own
+         * copy of the board. A thread takes the next root move not taken yet as soon as it's done
+         * with its last one, so the threads keep busy even though the subtrees differ in size.
+         * The counts are the same whatever the number of threads.
+         *
+         * @param[in]   board         The position to count the leaves of.
+         * @param[in]   depth         The depth of the tree, in plies, at least 1.
+         * @param[in]   thread_count  The number of threads to count with, at least 1.
+         * @param[in]   hash          The hash table shared by the threads, or nullptr.
+         *
+         * @return      The leaf count of every legal root move, in generation order.
+         */
+        std::vector<DivideEntry> Divide(const BoardArea& board, int depth,
+                                        unsigned int thread_count = 1,
+                                        PerftHash* hash = nullptr) noexcept;
+    }  // namespace perft
+}  // namespace raychess
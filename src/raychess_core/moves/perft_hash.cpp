@@ -0,0 +1,75 @@
+/**
+ * @file    perft_hash.cpp
+ *
+ * @brief   Hash table of perft leaf counts.
+ *
+ * @section DESCRIPTION
+ *
+ * Remembering the leaf count of every position and depth counted lets the repeated subtrees of a
+ * perft tree be skipped.
+ */
+
+#include "perft_hash.hpp"
+
+#include <exception>
+#include <new>
+
+using namespace raychess;
+
+perft::PerftHash::PerftHash(std::size_t size_mb) noexcept : mask_(0), size_mb_(size_mb)
+{
+    std::size_t count = 1;
+    while (count * 2 * sizeof(Entry) <= size_mb * 1024 * 1024) {
+        count *= 2;
+    }
+
+    // Half the size is tried whenever the memory can't be had, down to a single entry.
+    const std::size_t requested = count;
+    for (; count > 0; count /= 2) {
+        entries_.reset(new (std::nothrow) Entry[count]);
+        if (entries_) {
+            break;
+        }
+    }
+    if (!entries_) {
+        std::terminate();
+    }
+
+    if (count != requested) {
+        size_mb_ = count * sizeof(Entry) / (1024 * 1024);
+    }
+    mask_ = count - 1;
+    Clear();
+}
+
+bool perft::PerftHash::Probe(std::uint64_t key, int depth, std::uint64_t& nodes) const noexcept
+{
+    const Entry& entry = entries_[key & mask_];
+    const std::uint64_t data = entry.data.load(std::memory_order_relaxed);
+
+    if ((entry.key.load(std::memory_order_relaxed) ^ data) != key ||
+        static_cast<int>(data & 0xff) != depth) {
+        return false;
+    }
+
+    nodes = data >> 8;
+    return true;
+}
+
+void perft::PerftHash::Store(std::uint64_t key, int depth, std::uint64_t nodes) noexcept
+{
+    Entry& entry = entries_[key & mask_];
+    const std::uint64_t data = (nodes << 8) | static_cast<std::uint64_t>(depth);
+
+    entry.key.store(key ^ data, std::memory_order_relaxed);
+    entry.data.store(data, std::memory_order_relaxed);
+}
+
+void perft::PerftHash::Clear(void) noexcept
+{
+    // A zero depth is never stored, so zeroed entries never match.
+    for (std::size_t i = 0; i <= mask_; i++) {
+        entries_[i].key.store(0, std::memory_order_relaxed);
+        entries_[i].data.store(0, std::memory_order_relaxed);
+    }
+}
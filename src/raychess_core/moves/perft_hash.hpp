@@ -0,0 +1,93 @@
+/**
+ * @file    perft_hash.hpp
+ *
+ * @brief   Hash table of perft leaf counts.
+ *
+ * @section DESCRIPTION
+ *
+ * Many positions of a perft tree can be reached by more than one move order. Remembering the leaf
+ * count of every position and depth counted lets the repeated subtrees be skipped.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+namespace raychess
+{
+    namespace perft
+    {
+        /**
+         * @brief   Hash table of perft leaf counts, keyed by the position's key and the depth.
+         *
+         * The table can be shared by any number of threads without locking. Each entry is two
+         * 64-bit words written separately, the stored key being XORed with the data, so an entry
+         * torn by two threads writing it at once fails verification instead of returning a wrong
+         * count.
+         */
+        class PerftHash
+        {
+        public:
+            /**
+             * @brief       Constructor.
+             *
+             * @param[in]   size_mb  The size of the table in megabytes, rounded down to a power
+             * of two number of entries. A smaller table is made if the memory can't be allocated.
+             */
+            explicit PerftHash(std::size_t size_mb) noexcept;
+
+            /**
+             * @brief       Size getter.
+             *
+             * @return      The size of the table in megabytes, less than asked for if the memory
+             * couldn't be allocated.
+             */
+            std::size_t GetSizeMb(void) const noexcept { return size_mb_; }
+
+            /**
+             * @brief       Looks up the leaf count of a position.
+             *
+             * @param[in]   key    The key of the position.
+             * @param[in]   depth  The depth of the tree counted.
+             * @param[out]  nodes  The leaf count, if found.
+             *
+             * @return      True if the count was found, false otherwise.
+             */
+            bool Probe(std::uint64_t key, int depth, std::uint64_t& nodes) const noexcept;
+
+            /**
+             * @brief       Stores the leaf count of a position, replacing whatever was stored in
+             * its entry.
+             *
+             * @param[in]   key    The key of the position.
+             * @param[in]   depth  The depth of the tree counted.
+             * @param[in]   nodes  The leaf count.
+             */
+            void Store(std::uint64_t key, int depth, std::uint64_t nodes) noexcept;
+
+            /**
+             * @brief       Removes all counts from the table.
+             *
+             * Must not be called while other threads use the table.
+             */
+            void Clear(void) noexcept;
+
+        private:
+            /**
+             * @brief   A single entry, the depth is kept in the low byte of the data.
+             */
+            struct Entry
+            {
+                std::atomic<std::uint64_t> key;   ///< The position's key XORed with the data.
+                std::atomic<std::uint64_t> data;  ///< The leaf count and the depth.
+            };
+
+            std::unique_ptr<Entry[]> entries_;  ///< The entries.
+            std::size_t mask_;                  ///< Mask turning a key into an entry index.
+            std::size_t size_mb_;               ///< The size of the table in megabytes.
+        };
+    }  // namespace perft
+}  // namespace raychess
@@ -10,6 +10,7 @@
 
 #pragma once
 
+#include <memory>
 #include <vector>
 
 #include "piece_base.hpp"
@@ -28,13 +29,32 @@ namespace raychess
         using PieceBase::PieceBase;
 
         /**
-         * @brief       Get a vector of all possible moves for the piece.
+         * @brief       Make a copy of the piece.
          *
-         * @see         PieceBase::GetMoves()
+         * @see         PieceBase::Clone()
          *
-         * @return      A vector of all possible moves for the piece.
+         * @return      An owning pointer to the copy of the piece.
          */
-        std::vector<Position2D> GetMoves(const BoardArea& board) const noexcept override;
+        std::unique_ptr<PieceBase> Clone(void) const noexcept override;
+
+        /**
+         * @brief       Get the type of the piece.
+         *
+         * @see         PieceBase::GetType()
+         *
+         * @return      The type of the piece.
+         */
+        PieceType GetType(void) const noexcept override;
+
+        /**
+         * @brief       Append all possible moves for the piece to a move list.
+         *
+         * @see         PieceBase::GenerateMoves()
+         *
+         * @param[in]   board  The board the piece is on.
+         * @param[out]  moves  The list to append the moves to.
+         */
+        void GenerateMoves(const BoardArea& board, MoveList& moves) const noexcept override;
 
         /**
          * @brief       Using the default implementation of the Move method.
@@ -53,11 +73,11 @@ namespace raychess
         int GetPointEvaulation(void) const noexcept override;
 
         /**
-         * @brief       Using the default implementation of the GetAttackOnlyMoves method.
+         * @brief       Using the default implementation of the GenerateAttackOnlyMoves method.
          *
-         * @see         PieceBase::GetAttackOnlyMoves(void)
+         * @see         PieceBase::GenerateAttackOnlyMoves(void)
          */
-        using PieceBase::GetAttackOnlyMoves;
+        using PieceBase::GenerateAttackOnlyMoves;
 
         /**
          * @brief       Using the default implementation of the CanEnPassant method.
@@ -10,40 +10,28 @@
 
 #include "knight.hpp"
 
+#include "attacks.hpp"
+#include "board_area.hpp"
+
 using namespace raychess;
 
-std::vector<Position2D> Knight::GetMoves(const BoardArea& board) const noexcept
+std::unique_ptr<PieceBase> Knight::Clone(void) const noexcept
 {
-    std::vector<Position2D> moves;
-    moves.reserve(8);
-
-    Position2D new_position;
-
-    /*
-     * The way this algorithm works is iterating over all possible directions using the two for
-     * loops (each i, j pair could be considered a directional vector) and then adding the
-     * directional vector to the current position until the new position is out of bounds or there
-     * is a piece in the way. In case this piece is an enemy piece, the move is added to the list of
-     * possible moves as well.
-     */
-    for (int i = -2; i <= 2; i++) {
-        for (int j = -2; j <= 2; j++) {
-            if (i == 0 || j == 0 || i == j) {
-                continue;
-            }
-            new_position = position_ + Position2D(i, j);
-            // The move can be added to the list if it's within bounds and if there is either no
-            // piece or an enemy piece.
-            if (board.IsWithinBounds(new_position)) {
-                if (board.GetPieceAt(new_position) == nullptr ||
-                    board.GetPieceAt(new_position)->GetColour() != colour_) {
-                    moves.push_back(new_position);
-                }
-            }
-        }
-    }
-
-    return moves;
+    return std::make_unique<Knight>(*this);
+}
+
+PieceBase::PieceType Knight::GetType(void) const noexcept { return PieceType::KNIGHT; }
+
+void Knight::GenerateMoves(const BoardArea& board, MoveList& moves) const noexcept
+{
+    const int square = position_.ToSquareIndex();
+
+    // The table holds all squares the knight can jump to from here, only those occupied by own
+    // pieces and those outside of the board are left to filter out.
+    const Bitboard targets = attacks::KnightAttacks(square) & ~board.GetColourBitboard(colour_) &
+                             board.GetBoardMask();
+
+    AppendMoves(square, targets, board.GetColourBitboard(OppositeColour(colour_)), moves);
 }
 
 int Knight::GetPointEvaulation(void) const noexcept { return 3; }
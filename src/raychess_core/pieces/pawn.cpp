@@ -10,13 +10,20 @@
 
 #include "pawn.hpp"
 
+#include "attacks.hpp"
+#include "board_area.hpp"
+
 using namespace raychess;
 
-std::vector<Position2D> Pawn::GetMoves(const BoardArea& board) const noexcept
+std::unique_ptr<PieceBase> Pawn::Clone(void) const noexcept
 {
-    std::vector<Position2D> moves;
-    moves.reserve(2);
+    return std::make_unique<Pawn>(*this);
+}
+
+PieceBase::PieceType Pawn::GetType(void) const noexcept { return PieceType::PAWN; }
 
+void Pawn::GenerateMoves(const BoardArea& board, MoveList& moves) const noexcept
+{
     // Check whether we should move once or twice
     int available_moves = (has_moved_ ? 1 : 2);
 
@@ -35,15 +42,19 @@ std::vector<Position2D> Pawn::GetMoves(const BoardArea& board) const noexcept
         // The move can only be performed when it is within bounds and there isn't a piece (any
         // piece) at the given position. Given the moves are resolved sequentially in a direct,
         // pieces "in the way" block all other subsequent moves.
-        if (board.IsWithinBounds(new_position) && board.GetPieceAt(new_position) == nullptr) {
-            moves.push_back(new_position);
+        if (board.IsWithinBounds(new_position) && !board.IsOccupied(new_position)) {
+            if (i == 2) {
+                moves.PushBack(raychess::Move(position_, new_position,
+                                              raychess::Move::Flag::DOUBLE_PAWN_PUSH));
+            }
+            else {
+                AddMove(board, new_position, false, moves);
+            }
         }
         else {
             break;
         }
     }
-
-    return moves;
 }
 
 void Pawn::Move(Position2D new_position) noexcept
@@ -54,31 +65,15 @@ void Pawn::Move(Position2D new_position) noexcept
 
 int Pawn::GetPointEvaulation(void) const noexcept { return 1; }
 
-std::vector<Position2D> Pawn::GetAttackOnlyMoves(const BoardArea& board) const noexcept
+void Pawn::GenerateAttackOnlyMoves(const BoardArea& board, MoveList& moves) const noexcept
 {
-    std::vector<Position2D> moves;
-    moves.reserve(2);
-
-    // Iterate over left and right directions (the X axis)
-    for (int i = -1; i <= 1; i += 2) {
-        Position2D new_position = position_;
-
-        // Pawn's vertical direction depends on the colour of the piece, but it's always one tile
-        // "forward"
-        if (colour_ == PieceColour::WHITE) {
-            new_position += Position2D(i, 1);
-        }
-        else {
-            new_position += Position2D(i, -1);
-        }
+    // Only the squares diagonally forward with an enemy piece on them can be attacked.
+    Bitboard targets = attacks::PawnAttacks(colour_, position_.ToSquareIndex()) &
+                       board.GetColourBitboard(OppositeColour(colour_)) & board.GetBoardMask();
 
-        // If the tile is within bounds and there is an enemy piece there add it to the list.
-        if (board.IsWithinBounds(new_position) && board.GetPieceAt(new_position) != nullptr) {
-            moves.push_back(new_position);
-        }
+    while (targets != bitboard::kEmpty) {
+        AddMove(board, Position2D::FromSquareIndex(bitboard::PopLsb(targets)), true, moves);
     }
-
-    return moves;
 }
 
 bool Pawn::CanEnPassant(void) const noexcept { return true; }
@@ -88,9 +83,28 @@ bool Pawn::CanBePromoted(void) const noexcept
     if (colour_ == PieceColour::WHITE) {
         return position_.y == 7;
     }
-    else if (colour_ == PieceColour::BLACK) {
-        return position_.y == 0;
-    }
+    return position_.y == 0;
 }
 
 bool Pawn::CanMoveTwoSquares(void) const noexcept { return !has_moved_; }
+
+void Pawn::AddMove(const BoardArea& board, const Position2D& new_position, bool capture,
+                   MoveList& moves) const noexcept
+{
+    const int last_rank = (colour_ == PieceColour::WHITE ? board.GetDimensionY() - 1 : 0);
+
+    if (new_position.y != last_rank) {
+        moves.PushBack(raychess::Move(
+            position_, new_position,
+            capture ? raychess::Move::Flag::CAPTURE : raychess::Move::Flag::QUIET));
+        return;
+    }
+
+    // Reaching the last rank is a promotion, one move for each piece the pawn can become.
+    const PieceType promotions[] = {PieceType::QUEEN, PieceType::ROOK, PieceType::BISHOP,
+                                    PieceType::KNIGHT};
+    for (const auto promotion : promotions) {
+        moves.PushBack(raychess::Move(position_, new_position,
+                                      raychess::Move::PromotionFlag(promotion, capture)));
+    }
+}
@@ -10,6 +10,7 @@
 
 #pragma once
 
+#include <memory>
 #include <vector>
 
 #include "piece_base.hpp"
@@ -28,13 +29,32 @@ namespace raychess
         using PieceBase::PieceBase;
 
         /**
-         * @brief       Get a vector of all possible moves for the piece.
+         * @brief       Make a copy of the piece.
          *
-         * @see         PieceBase::GetMoves()
+         * @see         PieceBase::Clone()
          *
-         * @return      A vector of all possible moves for the piece.
+         * @return      An owning pointer to the copy of the piece.
          */
-        std::vector<Position2D> GetMoves(const BoardArea& board) const noexcept override;
+        std::unique_ptr<PieceBase> Clone(void) const noexcept override;
+
+        /**
+         * @brief       Get the type of the piece.
+         *
+         * @see         PieceBase::GetType()
+         *
+         * @return      The type of the piece.
+         */
+        PieceType GetType(void) const noexcept override;
+
+        /**
+         * @brief       Append all possible moves for the piece to a move list.
+         *
+         * @see         PieceBase::GenerateMoves()
+         *
+         * @param[in]   board  The board the piece is on.
+         * @param[out]  moves  The list to append the moves to.
+         */
+        void GenerateMoves(const BoardArea& board, MoveList& moves) const noexcept override;
 
         /**
          * @brief       Moves the piece to the given position while marking the piece as moved.
@@ -53,14 +73,16 @@ namespace raychess
         int GetPointEvaulation(void) const noexcept override;
 
         /**
-         * @brief       Get a vector of all possible moves for the piece, that can only end with an
-         * attack.
+         * @brief       Append all possible moves for the piece, that can only end with an attack,
+         * to a move list.
          *
-         * @see         PieceBase::GetAttackOnlyMoves()
+         * @see         PieceBase::GenerateAttackOnlyMoves()
          *
-         * @return      A vector of all possible attack-only moves for the piece.
+         * @param[in]   board  The board the piece is on.
+         * @param[out]  moves  The list to append the moves to.
          */
-        std::vector<Position2D> GetAttackOnlyMoves(const BoardArea& board) const noexcept override;
+        void GenerateAttackOnlyMoves(const BoardArea& board,
+                                     MoveList& moves) const noexcept override;
 
         /**
          * @brief       Checks if the piece can make an en passant move.
@@ -84,6 +106,17 @@ namespace raychess
         bool CanMoveTwoSquares(void) const noexcept override;
 
     private:
-        bool has_moved_;
+        /**
+         * @brief       Appends a move to the given position, or all its promotions.
+         *
+         * @param[in]   board         The board the piece is on.
+         * @param[in]   new_position  The position the pawn moves to.
+         * @param[in]   capture       Whether the move captures a piece.
+         * @param[out]  moves         The list to append the moves to.
+         */
+        void AddMove(const BoardArea& board, const Position2D& new_position, bool capture,
+                     MoveList& moves) const noexcept;
+
+        bool has_moved_ = false;  ///< Whether the pawn has already moved.
     };
 }  // namespace raychess
@@ -0,0 +1,40 @@
+/**
+ * @file    piece_base.cpp
+ *
+ * @brief   Base class representing a chess piece.
+ *
+ * @section DESCRIPTION
+ *
+ * This abstract class aims to provide a basic interface of methods a piece should support.
+ */
+
+#include "piece_base.hpp"
+
+#include "bishop.hpp"
+#include "king.hpp"
+#include "knight.hpp"
+#include "pawn.hpp"
+#include "queen.hpp"
+#include "rook.hpp"
+
+using namespace raychess;
+
+std::unique_ptr<PieceBase> PieceBase::Create(PieceType type, PieceColour colour,
+                                             Position2D position) noexcept
+{
+    switch (type) {
+        case PieceType::PAWN:
+            return std::make_unique<Pawn>(colour, position);
+        case PieceType::KNIGHT:
+            return std::make_unique<Knight>(colour, position);
+        case PieceType::BISHOP:
+            return std::make_unique<Bishop>(colour, position);
+        case PieceType::ROOK:
+            return std::make_unique<Rook>(colour, position);
+        case PieceType::QUEEN:
+            return std::make_unique<Queen>(colour, position);
+        case PieceType::KING:
+            return std::make_unique<King>(colour, position);
+    }
+    return nullptr;
+}
@@ -10,24 +10,34 @@
 
 #pragma once
 
+#include <memory>
 #include <vector>
 
+#include "bitboard.hpp"
+#include "move_list.hpp"
+#include "piece_types.hpp"
 #include "pos2d.hpp"
-#include "board_area.hpp"
 
 namespace raychess
 {
+    class BoardArea;
+
     class PieceBase
     {
     public:
         /**
          * @brief       Structure representing a piece colour.
+         *
+         * @see         raychess::PieceColour
          */
-        enum class PieceColour
-        {
-            WHITE,
-            BLACK
-        };
+        using PieceColour = raychess::PieceColour;
+
+        /**
+         * @brief       Structure representing a piece type.
+         *
+         * @see         raychess::PieceType
+         */
+        using PieceType = raychess::PieceType;
 
         /**
          * @brief       Constructor.
@@ -37,6 +47,32 @@ namespace raychess
         PieceBase(PieceColour colour, Position2D position) noexcept
             : colour_(colour), position_(position){};
 
+        /**
+         * @brief       Creates a piece of the given type.
+         *
+         * @param[in]   type      The type of the piece.
+         * @param[in]   colour    The colour of the piece.
+         * @param[in]   position  The position of the piece.
+         *
+         * @return      An owning pointer to the new piece.
+         */
+        static std::unique_ptr<PieceBase> Create(PieceType type, PieceColour colour,
+                                                 Position2D position) noexcept;
+
+        /**
+         * @brief       Virtual destructor, pieces are owned through base class pointers.
+         */
+        virtual ~PieceBase() = default;
+
+        /**
+         * @brief       Pure virtual method to make a copy of the piece.
+         *
+         * Areas own their pieces, so a piece passed to an area is copied using this method.
+         *
+         * @return      An owning pointer to the copy of the piece.
+         */
+        virtual std::unique_ptr<PieceBase> Clone(void) const noexcept = 0;
+
         /**
          * @brief       Colour getter.
          *
@@ -51,16 +87,44 @@ namespace raychess
          */
         Position2D GetPosition(void) const noexcept { return position_; }
 
+        /**
+         * @brief       Pure virtual method to get the type of the piece.
+         *
+         * @return      The type of the piece.
+         */
+        virtual PieceType GetType(void) const noexcept = 0;
+
         /**
          * @brief       Get a vector of all possible moves for the piece.
          *
          * Gets a vector of all possible moves for the piece. Not all moves on this vector are
-         * guaranteed to be valid moves. It's up to the game (usually a board) that has the
-         * information about other pieces to classivy the moves as valid, invalid or attack moves.
+         * guaranteed to be valid moves, as they may leave the king in check, and castling and en
+         * passant are not included. MoveGenerator generates only the legal moves of a position.
+         *
+         * This is a convenience wrapper around GenerateMoves(), which should be preferred wherever
+         * moves are generated often. A promotion is listed once, even though GenerateMoves() yields
+         * one move per promotion piece.
          *
          * @return      A vector of all possible moves for the piece.
          */
-        virtual std::vector<Position2D> GetMoves(const BoardArea& board) const noexcept = 0;
+        std::vector<Position2D> GetMoves(const BoardArea& board) const noexcept
+        {
+            MoveList moves;
+            GenerateMoves(board, moves);
+            return GetTargetPositions(moves);
+        }
+
+        /**
+         * @brief       Append all possible moves for the piece to a move list.
+         *
+         * Generates the same moves as GetMoves(), but appends them to a list supplied by the
+         * caller, so no memory is allocated. The moves carry their origin and flags telling
+         * captures and promotions apart.
+         *
+         * @param[in]   board  The board the piece is on.
+         * @param[out]  moves  The list to append the moves to.
+         */
+        virtual void GenerateMoves(const BoardArea& board, MoveList& moves) const noexcept = 0;
 
         /**
          * @brief       Moves the piece to a new position.
@@ -92,11 +156,29 @@ namespace raychess
          * @brief       Get a vector of all possible moves for the piece, that can only end with an
          * attack.
          *
-         * Applies onlly to pawns.
+         * Applies onlly to pawns. This is a convenience wrapper around GenerateAttackOnlyMoves().
          *
          * @return      A vector of all possible attack-only moves for the piece.
          */
-        virtual std::vector<Position2D> GetAttackOnlyMoves(const BoardArea& board) const noexcept { return {}; }
+        std::vector<Position2D> GetAttackOnlyMoves(const BoardArea& board) const noexcept
+        {
+            MoveList moves;
+            GenerateAttackOnlyMoves(board, moves);
+            return GetTargetPositions(moves);
+        }
+
+        /**
+         * @brief       Append all possible moves for the piece, that can only end with an attack,
+         * to a move list.
+         *
+         * Applies onlly to pawns, the default implementation appends nothing.
+         *
+         * @param[in]   board  The board the piece is on.
+         * @param[out]  moves  The list to append the moves to.
+         */
+        virtual void GenerateAttackOnlyMoves(const BoardArea& board, MoveList& moves) const noexcept
+        {
+        }
 
         /**
          * @brief       Checks if the piece can make an en passant move.
@@ -126,6 +208,48 @@ namespace raychess
         virtual bool CanMoveTwoSquares(void) const noexcept { return false; }
 
     protected:
+        /**
+         * @brief       Gets the target positions of a list of moves.
+         *
+         * Underpromotions are skipped, so that each promotion's target is only listed once.
+         *
+         * @param[in]   moves  The list of moves.
+         *
+         * @return      A vector of the target positions.
+         */
+        static std::vector<Position2D> GetTargetPositions(const MoveList& moves) noexcept
+        {
+            std::vector<Position2D> positions;
+            positions.reserve(moves.Size());
+
+            for (const raychess::Move& move : moves) {
+                if (!move.IsPromotion() || move.GetPromotionType() == PieceType::QUEEN) {
+                    positions.push_back(move.GetToPosition());
+                }
+            }
+            return positions;
+        }
+
+        /**
+         * @brief       Appends a move to each of the target squares to a move list.
+         *
+         * @param[in]   from     The square index the piece moves from.
+         * @param[in]   targets  The squares the piece can move to.
+         * @param[in]   enemies  The squares occupied by enemy pieces, moves there are captures.
+         * @param[out]  moves    The list to append the moves to.
+         */
+        static void AppendMoves(int from, Bitboard targets, Bitboard enemies,
+                                MoveList& moves) noexcept
+        {
+            while (targets != bitboard::kEmpty) {
+                const int to = bitboard::PopLsb(targets);
+                moves.PushBack(raychess::Move(from, to,
+                                              bitboard::IsSet(enemies, to)
+                                                  ? raychess::Move::Flag::CAPTURE
+                                                  : raychess::Move::Flag::QUIET));
+            }
+        }
+
         PieceColour colour_;   ///< The colour of the piece.
         Position2D position_;  ///< The position of the piece.
     };
@@ -0,0 +1,115 @@
+/**
+ * @file    piece_types.hpp
+ *
+ * @brief   Enumerations describing a chess piece.
+ *
+ * @section DESCRIPTION
+ *
+ * The colours and types of chess pieces. They live in their own header so that code which only
+ * needs to name a piece, such as moves, doesn't have to depend on the piece classes.
+ *
+ * A Piece combines a colour and a type into a single byte. It's what the board stores for each
+ * square and what move generation and evaluation work with, while the piece classes are kept for
+ * code which wants an object per piece, such as the user interface.
+ */
+
+#pragma once
+
+#include <cstdint>
+
+namespace raychess
+{
+    /**
+     * @brief       Structure representing a piece colour.
+     */
+    enum class PieceColour
+    {
+        WHITE,
+        BLACK
+    };
+
+    /**
+     * @brief       Gets the opposite colour.
+     *
+     * @param[in]   colour  The colour.
+     *
+     * @return      The colour of the opponent.
+     */
+    constexpr PieceColour OppositeColour(PieceColour colour) noexcept
+    {
+        return (colour == PieceColour::WHITE ? PieceColour::BLACK : PieceColour::WHITE);
+    }
+
+    /**
+     * @brief       Structure representing a piece type.
+     */
+    enum class PieceType
+    {
+        PAWN,
+        KNIGHT,
+        BISHOP,
+        ROOK,
+        QUEEN,
+        KING
+    };
+
+    /**
+     * @brief       Structure representing a piece of a given colour and type, in one byte.
+     *
+     * The type is held in the low three bits and the colour in the fourth bit, so the colour and
+     * the type are taken apart with a shift and a mask, see GetPieceColour() and GetPieceType().
+     */
+    enum class Piece : std::uint8_t
+    {
+        WHITE_PAWN = 0,
+        WHITE_KNIGHT = 1,
+        WHITE_BISHOP = 2,
+        WHITE_ROOK = 3,
+        WHITE_QUEEN = 4,
+        WHITE_KING = 5,
+        BLACK_PAWN = 8,
+        BLACK_KNIGHT = 9,
+        BLACK_BISHOP = 10,
+        BLACK_ROOK = 11,
+        BLACK_QUEEN = 12,
+        BLACK_KING = 13,
+        NONE = 15  ///< No piece, such as on an empty square.
+    };
+
+    /**
+     * @brief       Combines a colour and a type into a piece.
+     *
+     * @param[in]   colour  The colour of the piece.
+     * @param[in]   type    The type of the piece.
+     *
+     * @return      The piece.
+     */
+    constexpr Piece MakePiece(PieceColour colour, PieceType type) noexcept
+    {
+        return static_cast<Piece>(static_cast<int>(colour) << 3 | static_cast<int>(type));
+    }
+
+    /**
+     * @brief       Gets the colour of a piece.
+     *
+     * @param[in]   piece  The piece, which must not be Piece::NONE.
+     *
+     * @return      The colour of the piece.
+     */
+    constexpr PieceColour GetPieceColour(Piece piece) noexcept
+    {
+        return static_cast<PieceColour>(static_cast<int>(piece) >> 3);
+    }
+
+    /**
+     * @brief       Gets the type of a piece.
+     *
+     * @param[in]   piece  The piece, which must not be Piece::NONE.
+     *
+     * @return      The type of the piece.
+     */
+    constexpr PieceType GetPieceType(Piece piece) noexcept
+    {
+        return static_cast<PieceType>(static_cast<int>(piece) & 7);
+    }
+}  // namespace raychess
@@ -0,0 +1,232 @@
+/**
+ * @file    evaluation.cpp
+ *
+ * @brief   Static evaluation of positions.
+ *
+ * @section DESCRIPTION
+ *
+ * The evaluation estimates how good a position is without searching it, in centipawns. It scores
+ * the material and the placement of the pieces and the pawn structure, tapered between the
+ * middlegame and the endgame.
+ */
+
+#include "evaluation.hpp"
+
+#include <algorithm>
+
+#include "attacks.hpp"
+#include "move_generator.hpp"
+#include "piece_square_tables.hpp"
+
+using namespace raychess;
+
+namespace
+{
+    // Pawn structure scores, middlegame and endgame.
+    constexpr int kDoubledMiddlegame = -10;
+    constexpr int kDoubledEndgame = -25;
+    constexpr int kIsolatedMiddlegame = -12;
+    constexpr int kIsolatedEndgame = -15;
+    constexpr int kBackwardMiddlegame = -8;
+    constexpr int kBackwardEndgame = -10;
+
+    // Values of the pieces in exchanges. The king is worth more than everything else together,
+    // so capturing with it is only good when it can't be recaptured.
+    constexpr int kExchangeValues[BoardArea::kPieceTypeCount] = {100, 320, 330, 500, 900, 20000};
+
+    // Passed pawn bonuses by the rank from the pawn's side of the board.
+    constexpr int kPassedMiddlegame[bitboard::kBoardSize] = {0, 5, 10, 15, 25, 40, 60, 0};
+    constexpr int kPassedEndgame[bitboard::kBoardSize] = {0, 10, 20, 35, 60, 100, 150, 0};
+
+    /**
+     * @brief       Gets the ranks in front of a rank, from a side's point of view.
+     *
+     * @param[in]   colour  The side.
+     * @param[in]   rank    The rank.
+     *
+     * @return      A bitboard of the squares of all ranks in front of the rank.
+     */
+    Bitboard RanksInFront(PieceColour colour, int rank) noexcept
+    {
+        if (colour == PieceColour::WHITE) {
+            return (rank + 1 < bitboard::kBoardSize
+                        ? ~Bitboard(0) << ((rank + 1) * bitboard::kBoardSize)
+                        : bitboard::kEmpty);
+        }
+        return (Bitboard(1) << (rank * bitboard::kBoardSize)) - 1;
+    }
+
+    /**
+     * @brief       Gets the files next to a file.
+     *
+     * @param[in]   file  The file.
+     *
+     * @return      A bitboard of the squares of the files next to the file.
+     */
+    Bitboard AdjacentFiles(int file) noexcept
+    {
+        const Bitboard mask = bitboard::FileMask(file);
+        return ((mask << 1) & ~bitboard::kFileA) | ((mask >> 1) & ~bitboard::kFileH);
+    }
+
+    /**
+     * @brief       Evaluates the pawns of one side.
+     *
+     * @param[in]   board       The board holding the position.
+     * @param[in]   colour      The side.
+     * @param[out]  middlegame  The middlegame score, positive if the side's pawns are good.
+     * @param[out]  endgame     The endgame score, positive if the side's pawns are good.
+     */
+    void EvaluateSidePawns(const BoardArea& board, PieceColour colour, int& middlegame,
+                           int& endgame) noexcept
+    {
+        const Bitboard own_pawns = board.GetPieceBitboard(colour, PieceType::PAWN);
+        const Bitboard enemy_pawns =
+            board.GetPieceBitboard(OppositeColour(colour), PieceType::PAWN);
+        const int forward =
+            (colour == PieceColour::WHITE ? bitboard::kBoardSize : -bitboard::kBoardSize);
+
+        middlegame = 0;
+        endgame = 0;
+
+        Bitboard pawns = own_pawns;
+        while (pawns != bitboard::kEmpty) {
+            const int square = bitboard::PopLsb(pawns);
+            const int file = square % bitboard::kBoardSize;
+            const int rank = square / bitboard::kBoardSize;
+            const Bitboard file_mask = bitboard::FileMask(file);
+            const Bitboard adjacent_files = AdjacentFiles(file);
+            const Bitboard in_front = RanksInFront(colour, rank);
+            const int stop_square = square + forward;
+
+            // Only the rear pawn of a doubled pair counts as doubled.
+            const bool doubled = (own_pawns & file_mask & in_front) != bitboard::kEmpty;
+            if (doubled) {
+                middlegame += kDoubledMiddlegame;
+                endgame += kDoubledEndgame;
+            }
+
+            if ((own_pawns & adjacent_files) == bitboard::kEmpty) {
+                middlegame += kIsolatedMiddlegame;
+                endgame += kIsolatedEndgame;
+            }
+            // A backward pawn has no pawns beside or behind it to support its advance, and can't
+            // advance safely on its own.
+            else if ((own_pawns & adjacent_files & ~in_front) == bitboard::kEmpty &&
+                     stop_square >= 0 && stop_square < bitboard::kSquareCount &&
+                     (attacks::PawnAttacks(colour, stop_square) & enemy_pawns) !=
+                         bitboard::kEmpty) {
+                middlegame += kBackwardMiddlegame;
+                endgame += kBackwardEndgame;
+            }
+
+            if (!doubled &&
+                (enemy_pawns & (file_mask | adjacent_files) & in_front) == bitboard::kEmpty) {
+                const int relative_rank =
+                    (colour == PieceColour::WHITE ? rank : bitboard::kBoardSize - 1 - rank);
+
+                middlegame += kPassedMiddlegame[relative_rank];
+                endgame += kPassedEndgame[relative_rank];
+            }
+        }
+    }
+}  // namespace
+
+void evaluation::EvaluatePawns(const BoardArea& board, int& middlegame, int& endgame) noexcept
+{
+    int white_middlegame, white_endgame, black_middlegame, black_endgame;
+
+    EvaluateSidePawns(board, PieceColour::WHITE, white_middlegame, white_endgame);
+    EvaluateSidePawns(board, PieceColour::BLACK, black_middlegame, black_endgame);
+
+    middlegame = white_middlegame - black_middlegame;
+    endgame = white_endgame - black_endgame;
+}
+
+int evaluation::Evaluate(const BoardArea& board, PawnHash* pawn_hash) noexcept
+{
+    int pawn_middlegame, pawn_endgame;
+    if (pawn_hash == nullptr) {
+        EvaluatePawns(board, pawn_middlegame, pawn_endgame);
+    }
+    else if (!pawn_hash->Probe(board.GetPawnKey(), pawn_middlegame, pawn_endgame)) {
+        EvaluatePawns(board, pawn_middlegame, pawn_endgame);
+        pawn_hash->Store(board.GetPawnKey(), pawn_middlegame, pawn_endgame);
+    }
+
+    // The board keeps the piece-square scores up to date, so all that's left is blending them by
+    // the phase. Promotions can push the phase above the maximum, which is still a middlegame.
+    const int phase = std::min(board.GetPhase(), psqt::kMaxPhase);
+    const int middlegame = board.GetMiddlegameScore() + pawn_middlegame;
+    const int endgame = board.GetEndgameScore() + pawn_endgame;
+    const int score =
+        (middlegame * phase + endgame * (psqt::kMaxPhase - phase)) / psqt::kMaxPhase;
+
+    return board.GetSideToMove() == PieceColour::WHITE ? score : -score;
+}
+
+int evaluation::StaticExchange(const BoardArea& board, Move move) noexcept
+{
+    const int from = move.GetFrom();
+    const int to = move.GetTo();
+    PieceColour side = board.GetSideToMove();
+    PieceType attacker = GetPieceType(board.GetPiece(from));
+    Bitboard occupied = board.GetOccupiedBitboard() ^ bitboard::SquareBit(from);
+
+    // gains[i] is what the side making the i-th capture wins if the exchange stops after it.
+    int gains[bitboard::kSquareCount];
+    int depth = 0;
+
+    if (move.IsEnPassant()) {
+        gains[0] = kExchangeValues[static_cast<int>(PieceType::PAWN)];
+        occupied ^= bitboard::SquareBit((from & ~7) | (to & 7));
+    }
+    else {
+        gains[0] = move.IsCapture()
+                       ? kExchangeValues[static_cast<int>(GetPieceType(board.GetPiece(to)))]
+                       : 0;
+    }
+    if (move.IsPromotion()) {
+        attacker = move.GetPromotionType();
+        gains[0] += kExchangeValues[static_cast<int>(attacker)] -
+                    kExchangeValues[static_cast<int>(PieceType::PAWN)];
+    }
+
+    Bitboard attackers = MoveGenerator::GetAttackersTo(board, to, occupied) & occupied;
+
+    for (;;) {
+        side = OppositeColour(side);
+
+        // The least valuable piece of the side makes the next capture.
+        const Bitboard own_attackers = attackers & board.GetColourBitboard(side);
+        Bitboard capturer = bitboard::kEmpty;
+        PieceType capturer_type = PieceType::PAWN;
+        for (int type = 0; type < BoardArea::kPieceTypeCount && own_attackers != bitboard::kEmpty;
+             type++) {
+            capturer = own_attackers & board.GetPieceBitboard(side, static_cast<PieceType>(type));
+            if (capturer != bitboard::kEmpty) {
+                capturer_type = static_cast<PieceType>(type);
+                break;
+            }
+        }
+        if (capturer == bitboard::kEmpty) {
+            break;
+        }
+
+        depth++;
+        gains[depth] = kExchangeValues[static_cast<int>(attacker)] - gains[depth - 1];
+
+        // Removing the capturer may uncover a slider behind it.
+        occupied ^= bitboard::SquareBit(bitboard::LsbIndex(capturer));
+        attackers = MoveGenerator::GetAttackersTo(board, to, occupied) & occupied;
+        attacker = capturer_type;
+    }
+
+    // Each side stops capturing when going on would lose it material.
+    while (depth > 0) {
+        gains[depth - 1] = -std::max(-gains[depth - 1], gains[depth]);
+        depth--;
+    }
+
+    return gains[0];
+}
@@ -0,0 +1,74 @@
+/**
+ * @file    evaluation.hpp
+ *
+ * @brief   Static evaluation of positions.
+ *
+ * @section DESCRIPTION
+ *
+ * The evaluation estimates how good a position is without searching it, in centipawns (hundredths
+ * of a pawn).
+ */
+
+#pragma once
+
+#include "board_area.hpp"
+#include "move.hpp"
+#include "pawn_hash.hpp"
+
+namespace raychess
+{
+    namespace evaluation
+    {
+        /**
+         * @brief   Rough values of the pieces in centipawns, by PieceType.
+         *
+         * The evaluation uses the piece-square tables, these values are for telling which piece
+         * is worth more, such as when ordering captures. The king can't be traded, so it has no
+         * value.
+         */
+        constexpr int kPieceValues[BoardArea::kPieceTypeCount] = {100, 320, 330, 500, 900, 0};
+
+        /**
+         * @brief       Evaluates the pawn structure of a position.
+         *
+         * Scores doubled, isolated, backward and passed pawns.
+         *
+         * @param[in]   board       The board holding the position.
+         * @param[out]  middlegame  The middlegame score, positive if white is better.
+         * @param[out]  endgame     The endgame score, positive if white is better.
+         */
+        void EvaluatePawns(const BoardArea& board, int& middlegame, int& endgame) noexcept;
+
+        /**
+         * @brief       Evaluates a position from the side to move's point of view.
+         *
+         * The middlegame and endgame piece-square scores BoardArea keeps and the scores of the
+         * pawn structure are blended by the game phase. With a pawn hash, the pawn structure is
+         * only evaluated when it isn't cached, so the evaluation mostly costs a few additions and
+         * multiplications.
+         *
+         * @param[in]   board      The board holding the position.
+         * @param[in]   pawn_hash  The pawn hash to cache the pawn structure in, may be nullptr.
+         *
+         * @return      The score of the position in centipawns, positive if the side to move is
+         * better.
+         */
+        int Evaluate(const BoardArea& board, PawnHash* pawn_hash = nullptr) noexcept;
+
+        /**
+         * @brief       Works out the material a move wins once all captures on its target square
+         * have been played out.
+         *
+         * Both sides capture with their least valuable piece first and may stop capturing when
+         * that is better for them, pieces behind the capturers join in as they are uncovered.
+         * Pins and checks are ignored.
+         *
+         * @param[in]   board  The board holding the position.
+         * @param[in]   move   A legal capture or promotion.
+         *
+         * @return      The material the side to move wins in centipawns, negative if it loses
+         * material.
+         */
+        int StaticExchange(const BoardArea& board, Move move) noexcept;
+    }  // namespace evaluation
+}  // namespace raychess
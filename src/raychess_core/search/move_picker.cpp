@@ -0,0 +1,240 @@
+/**
+ * @file    move_picker.cpp
+ *
+ * @brief   Hands out the moves of a search node one at a time, best first.
+ *
+ * @section DESCRIPTION
+ *
+ * The moves are produced in stages, the likely best ones first, and the later stages are only
+ * generated if the search gets that far.
+ */
+
+#include "move_picker.hpp"
+
+#include <utility>
+
+#include "evaluation.hpp"
+
+using namespace raychess;
+using namespace raychess::search;
+
+namespace
+{
+    constexpr int kCaptureScore = 1 << 24;  ///< Ordering score of the evasions capturing a piece.
+
+    /**
+     * @brief       Gets the value of what a capture or promotion gains before any recapture.
+     *
+     * @param[in]   board  The board holding the position.
+     * @param[in]   move   The capture or promotion.
+     *
+     * @return      The value of the captured piece and of the promotion, in centipawns.
+     */
+    int GetImmediateGain(const BoardArea& board, Move move) noexcept
+    {
+        int gain = 0;
+
+        if (move.IsEnPassant()) {
+            gain = evaluation::kPieceValues[static_cast<int>(PieceType::PAWN)];
+        }
+        else if (move.IsCapture()) {
+            gain = evaluation::kPieceValues[static_cast<int>(
+                GetPieceType(board.GetPiece(move.GetTo())))];
+        }
+        if (move.IsPromotion()) {
+            gain += evaluation::kPieceValues[static_cast<int>(move.GetPromotionType())] -
+                    evaluation::kPieceValues[static_cast<int>(PieceType::PAWN)];
+        }
+
+        return gain;
+    }
+}  // namespace
+
+MovePicker::MovePicker(const BoardArea& board, const MoveGenerator& generator, Move tt_move,
+                       const Move (&killers)[2], const HistoryTable& history) noexcept
+    : board_(board),
+      generator_(generator),
+      history_(history),
+      stage_(Stage::TT_MOVE),
+      quiescence_(false),
+      tt_move_(generator.IsLegal(tt_move) ? tt_move : Move()),
+      killers_{killers[0], killers[1]},
+      current_(0)
+{
+}
+
+MovePicker::MovePicker(const BoardArea& board, const MoveGenerator& generator,
+                       const HistoryTable& history) noexcept
+    : board_(board),
+      generator_(generator),
+      history_(history),
+      stage_(generator.IsInCheck() ? Stage::GENERATE_EVASIONS : Stage::GENERATE_CAPTURES),
+      quiescence_(true),
+      current_(0)
+{
+}
+
+Move MovePicker::Next(void) noexcept
+{
+    for (;;) {
+        switch (stage_) {
+            case Stage::TT_MOVE:
+                stage_ = generator_.IsInCheck() ? Stage::GENERATE_EVASIONS
+                                                : Stage::GENERATE_CAPTURES;
+                if (tt_move_.IsValid()) {
+                    return tt_move_;
+                }
+                break;
+
+            case Stage::GENERATE_CAPTURES:
+                generator_.GenerateMoves<MoveGenerator::Mode::CAPTURES>(moves_);
+                ScoreCaptures();
+                stage_ = Stage::GOOD_CAPTURES;
+                break;
+
+            case Stage::GOOD_CAPTURES:
+                while (current_ < moves_.Size()) {
+                    const Move move = PickBest();
+
+                    if (move == tt_move_ || (quiescence_ && move.IsPromotion() &&
+                                             move.GetPromotionType() != PieceType::QUEEN)) {
+                        continue;
+                    }
+
+                    // Taking a piece worth at least as much as the capturer can't lose material,
+                    // only the other captures need the exchange played out.
+                    const int gain = GetImmediateGain(board_, move);
+                    const int attacker = evaluation::kPieceValues[static_cast<int>(
+                        GetPieceType(board_.GetPiece(move.GetFrom())))];
+                    if (gain < attacker && evaluation::StaticExchange(board_, move) < 0) {
+                        if (!quiescence_) {
+                            bad_captures_.PushBack(move);
+                        }
+                        continue;
+                    }
+
+                    return move;
+                }
+                stage_ = quiescence_ ? Stage::DONE : Stage::FIRST_KILLER;
+                break;
+
+            case Stage::FIRST_KILLER:
+            case Stage::SECOND_KILLER: {
+                const int index = stage_ == Stage::FIRST_KILLER ? 0 : 1;
+                const Move killer = killers_[index];
+
+                stage_ = stage_ == Stage::FIRST_KILLER ? Stage::SECOND_KILLER
+                                                       : Stage::GENERATE_QUIETS;
+
+                // Killers come from other positions, so they may not even be legal here. Those
+                // which are captures or promotions now were handed out with the captures.
+                if (killer != tt_move_ && (index == 0 || killer != killers_[0]) &&
+                    !killer.IsCapture() && !killer.IsPromotion() && generator_.IsLegal(killer)) {
+                    return killer;
+                }
+                killers_[index] = Move();
+                break;
+            }
+
+            case Stage::GENERATE_QUIETS:
+                moves_.Clear();
+                current_ = 0;
+                generator_.GenerateMoves<MoveGenerator::Mode::QUIETS>(moves_);
+                ScoreQuiets();
+                stage_ = Stage::QUIETS;
+                break;
+
+            case Stage::QUIETS:
+                while (current_ < moves_.Size()) {
+                    const Move move = PickBest();
+
+                    if (!WasHandedOut(move)) {
+                        return move;
+                    }
+                }
+                current_ = 0;
+                stage_ = Stage::BAD_CAPTURES;
+                break;
+
+            case Stage::BAD_CAPTURES:
+                // The bad captures were set aside best first already.
+                if (current_ < bad_captures_.Size()) {
+                    return bad_captures_[current_++];
+                }
+                stage_ = Stage::DONE;
+                break;
+
+            case Stage::GENERATE_EVASIONS:
+                generator_.GenerateMoves<MoveGenerator::Mode::EVASIONS>(moves_);
+                ScoreEvasions();
+                stage_ = Stage::EVASIONS;
+                break;
+
+            case Stage::EVASIONS:
+                while (current_ < moves_.Size()) {
+                    const Move move = PickBest();
+
+                    if (move != tt_move_) {
+                        return move;
+                    }
+                }
+                stage_ = Stage::DONE;
+                break;
+
+            case Stage::DONE:
+                return Move();
+        }
+    }
+}
+
+void MovePicker::ScoreCaptures(void) noexcept
+{
+    for (std::size_t i = 0; i < moves_.Size(); i++) {
+        const Move move = moves_[i];
+        const PieceType attacker = GetPieceType(board_.GetPiece(move.GetFrom()));
+
+        scores_[i] = 100 * GetImmediateGain(board_, move) - static_cast<int>(attacker);
+    }
+}
+
+void MovePicker::ScoreQuiets(void) noexcept
+{
+    for (std::size_t i = 0; i < moves_.Size(); i++) {
+        scores_[i] = history_[moves_[i].GetFrom()][moves_[i].GetTo()];
+    }
+}
+
+void MovePicker::ScoreEvasions(void) noexcept
+{
+    for (std::size_t i = 0; i < moves_.Size(); i++) {
+        const Move move = moves_[i];
+
+        if (move.IsCapture() || move.IsPromotion()) {
+            const PieceType attacker = GetPieceType(board_.GetPiece(move.GetFrom()));
+            scores_[i] =
+                kCaptureScore + 100 * GetImmediateGain(board_, move) - static_cast<int>(attacker);
+        }
+        else {
+            scores_[i] = history_[move.GetFrom()][move.GetTo()];
+        }
+    }
+}
+
+Move MovePicker::PickBest(void) noexcept
+{
+    std::size_t best = current_;
+    for (std::size_t i = current_ + 1; i < moves_.Size(); i++) {
+        if (scores_[i] > scores_[best]) {
+            best = i;
+        }
+    }
+
+    std::swap(moves_[current_], moves_[best]);
+    std::swap(scores_[current_], scores_[best]);
+    return moves_[current_++];
+}
+
+bool MovePicker::WasHandedOut(Move move) const noexcept
+{
+    return move == tt_move_ || move == killers_[0] || move == killers_[1];
+}
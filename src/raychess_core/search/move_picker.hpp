@@ -0,0 +1,155 @@
+/**
+ * @file    move_picker.hpp
+ *
+ * @brief   Hands out the moves of a search node one at a time, best first.
+ *
+ * @section DESCRIPTION
+ *
+ * Most nodes of a search are cut off by their first or second move, so the moves are produced in
+ * stages, the likely best ones first, and the later stages are only generated if the search gets
+ * that far.
+ */
+
+#pragma once
+
+#include <cstddef>
+
+#include "bitboard.hpp"
+#include "board_area.hpp"
+#include "move.hpp"
+#include "move_generator.hpp"
+#include "move_list.hpp"
+
+namespace raychess
+{
+    namespace search
+    {
+        /**
+         * @brief   Hands out the legal moves of a position one at a time, best first.
+         *
+         * Out of check, the moves come in stages:
+         * - the best move from the transposition table,
+         * - the captures which don't lose material, by the most valuable victim and the least
+         *   valuable attacker, and pawn pushes promoting to a queen,
+         * - the killer moves,
+         * - the other quiet moves, by their history,
+         * - the captures which lose material.
+         *
+         * In check, the move from the transposition table is followed by the other evasions,
+         * captures first. Every move is handed out once.
+         *
+         * The picker keeps references to the board, the generator and the history, which must
+         * not change while it is in use.
+         */
+        class MovePicker
+        {
+        public:
+            /**
+             * @brief   History of the quiet moves of one side, by from and to square.
+             */
+            using HistoryTable = int[bitboard::kSquareCount][bitboard::kSquareCount];
+
+            /**
+             * @brief       Constructor for the main search, handing out all moves.
+             *
+             * @param[in]   board      The board holding the position.
+             * @param[in]   generator  The move generator of the position.
+             * @param[in]   tt_move    The best move from the transposition table, or "no move". It
+             * needn't be legal, it's skipped if it isn't.
+             * @param[in]   killers    The two killer moves of the ply, same as the move from the
+             * transposition table.
+             * @param[in]   history    The history of the side to move.
+             */
+            MovePicker(const BoardArea& board, const MoveGenerator& generator, Move tt_move,
+                       const Move (&killers)[2], const HistoryTable& history) noexcept;
+
+            /**
+             * @brief       Constructor for the quiescence search.
+             *
+             * Out of check, only the captures which don't lose material and the promotions to a
+             * queen are handed out. In check, all evasions are.
+             *
+             * @param[in]   board      The board holding the position.
+             * @param[in]   generator  The move generator of the position.
+             * @param[in]   history    The history of the side to move.
+             */
+            MovePicker(const BoardArea& board, const MoveGenerator& generator,
+                       const HistoryTable& history) noexcept;
+
+            /**
+             * @brief       Gets the next move.
+             *
+             * @return      The next best move, or "no move" once all moves were handed out.
+             */
+            Move Next(void) noexcept;
+
+        private:
+            /**
+             * @brief   The stages of the picker, in the order they are gone through.
+             */
+            enum class Stage
+            {
+                TT_MOVE,
+                GENERATE_CAPTURES,
+                GOOD_CAPTURES,
+                FIRST_KILLER,
+                SECOND_KILLER,
+                GENERATE_QUIETS,
+                QUIETS,
+                BAD_CAPTURES,
+                GENERATE_EVASIONS,
+                EVASIONS,
+                DONE
+            };
+
+            /**
+             * @brief       Scores the captures (and promotions), most valuable victim first.
+             */
+            void ScoreCaptures(void) noexcept;
+
+            /**
+             * @brief       Scores the quiet moves by their history.
+             */
+            void ScoreQuiets(void) noexcept;
+
+            /**
+             * @brief       Scores the evasions, captures first and then by history.
+             */
+            void ScoreEvasions(void) noexcept;
+
+            /**
+             * @brief       Takes the best scored of the remaining moves.
+             *
+             * Picking moves one at a time is cheaper than sorting, as most nodes are cut off after
+             * the first few moves.
+             *
+             * @return      The best remaining move, which must exist.
+             */
+            Move PickBest(void) noexcept;
+
+            /**
+             * @brief       Checks whether a move was handed out by an earlier stage.
+             *
+             * @param[in]   move  The move.
+             *
+             * @return      True if the move is the move from the transposition table or a killer
+             * move which was handed out, false otherwise.
+             */
+            bool WasHandedOut(Move move) const noexcept;
+
+            const BoardArea& board_;          ///< The board holding the position.
+            const MoveGenerator& generator_;  ///< The move generator of the position.
+            const HistoryTable& history_;     ///< The history of the side to move.
+            Stage stage_;                     ///< The current stage.
+            bool quiescence_;                 ///< Whether only good captures are handed out.
+
+            Move tt_move_;     ///< The move from the transposition table, if legal.
+            Move killers_[2];  ///< The killer moves, if legal quiet moves.
+
+            MoveList moves_;         ///< The moves of the current stage.
+            int scores_[kMaxMoves];  ///< The scores of the moves of the current stage.
+            std::size_t current_;    ///< Index of the next move of the current stage.
+            MoveList bad_captures_;  ///< Captures losing material, handed out last.
+        };
+    }  // namespace search
+}  // namespace raychess
@@ -0,0 +1,106 @@
+/**
+ * @file    parallel_searcher.cpp
+ *
+ * @brief   Alpha-beta search of the game tree on several threads.
+ *
+ * @section DESCRIPTION
+ *
+ * The parallel searcher runs several searchers on the same position at once, sharing only the
+ * transposition table.
+ */
+
+#include "parallel_searcher.hpp"
+
+#include <algorithm>
+#include <thread>
+
+using namespace raychess;
+using namespace raychess::search;
+
+ParallelSearcher::ParallelSearcher(TranspositionTable& table, unsigned int thread_count) noexcept
+    : table_(table)
+{
+    SetThreadCount(thread_count);
+}
+
+Result ParallelSearcher::Search(const BoardArea& board, const std::vector<std::uint64_t>& history,
+                                const Limits& limits, const std::atomic<bool>& stop,
+                                const IterationCallback& callback) noexcept
+{
+    // The helpers have no limits of their own, they search until the main searcher is done.
+    std::atomic<bool> helpers_stop(false);
+    std::vector<Result> results(searchers_.size());
+    Limits helper_limits;
+    helper_limits.depth = limits.depth;
+
+    std::vector<std::thread> helpers;
+    for (std::size_t i = 1; i < searchers_.size(); i++) {
+        helpers.emplace_back([&, i]() {
+            results[i] = searchers_[i]->Search(board, history, helper_limits, helpers_stop,
+                                               IterationCallback());
+        });
+    }
+
+    const auto report_iteration = [&](const Result& result) {
+        Result total = result;
+        total.nodes = GetTotalNodes();
+        callback(total);
+    };
+
+    results[0] = searchers_[0]->Search(board, history, limits, stop,
+                                       callback ? report_iteration : IterationCallback());
+
+    helpers_stop = true;
+    for (auto& helper : helpers) {
+        helper.join();
+    }
+
+    reports_.assign(searchers_.size(), ThreadReport());
+    for (std::size_t i = 0; i < searchers_.size(); i++) {
+        reports_[i].nodes = results[i].nodes;
+        reports_[i].depth = results[i].depth;
+        reports_[i].nodes_per_second = results[0].seconds > 0.0
+                                           ? static_cast<double>(results[i].nodes) /
+                                                 results[0].seconds
+                                           : 0.0;
+
+        const PawnHash::Statistics pawn_hash = searchers_[i]->GetPawnHashStatistics();
+        reports_[i].pawn_hash_hits = pawn_hash.hits;
+        reports_[i].pawn_hash_misses = pawn_hash.misses;
+
+        const TranspositionTable::Statistics& table = searchers_[i]->GetTableStatistics();
+        reports_[i].table_hits = table.hits;
+        reports_[i].table_misses = table.misses;
+        reports_[i].table_collisions = table.collisions;
+    }
+
+    Result result = std::move(results[0]);
+    result.nodes = GetTotalNodes();
+    return result;
+}
+
+void ParallelSearcher::ClearHeuristics(void) noexcept
+{
+    for (auto& searcher : searchers_) {
+        searcher->ClearHeuristics();
+    }
+}
+
+void ParallelSearcher::SetThreadCount(unsigned int thread_count) noexcept
+{
+    thread_count = std::max(1u, thread_count);
+
+    searchers_.resize(std::min<std::size_t>(searchers_.size(), thread_count));
+    while (searchers_.size() < thread_count) {
+        searchers_.emplace_back(new Searcher(table_, static_cast<unsigned int>(searchers_.size())));
+    }
+}
+
+std::uint64_t ParallelSearcher::GetTotalNodes(void) const noexcept
+{
+    std::uint64_t nodes = 0;
+    for (const auto& searcher : searchers_) {
+        nodes += searcher->GetNodes();
+    }
+    return nodes;
+}
@@ -0,0 +1,119 @@
+/**
+ * @file    parallel_searcher.hpp
+ *
+ * @brief   Alpha-beta search of the game tree on several threads.
+ *
+ * @section DESCRIPTION
+ *
+ * The parallel searcher runs several searchers on the same position at once (Lazy SMP). They
+ * don't divide the tree between them, they only share the transposition table, so what one
+ * thread finds saves the others from searching it.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "board_area.hpp"
+#include "searcher.hpp"
+#include "transposition_table.hpp"
+
+namespace raychess
+{
+    namespace search
+    {
+        /**
+         * @brief   What a single thread of a parallel search did.
+         */
+        struct ThreadReport
+        {
+            std::uint64_t nodes = 0;             ///< Number of nodes the thread searched.
+            int depth = 0;                       ///< The depth of its last completed iteration.
+            double nodes_per_second = 0.0;       ///< Its search speed.
+            std::uint64_t pawn_hash_hits = 0;    ///< Evaluations which found their pawns cached.
+            std::uint64_t pawn_hash_misses = 0;  ///< Evaluations which evaluated their pawns.
+            std::uint64_t table_hits = 0;        ///< Table probes which found their position.
+            std::uint64_t table_misses = 0;      ///< Table probes which didn't.
+            std::uint64_t table_collisions = 0;  ///< Stores replacing another position's entry.
+        };
+
+        /**
+         * @brief   Alpha-beta searcher running on several threads.
+         *
+         * The calling thread runs the main searcher, whose result is the result of the search,
+         * and the other threads run helpers which only fill the shared transposition table. The
+         * helpers are stopped as soon as the main searcher finishes.
+         */
+        class ParallelSearcher
+        {
+        public:
+            /**
+             * @brief       Constructor.
+             *
+             * @param[in]   table         The transposition table shared by the threads.
+             * @param[in]   thread_count  The number of threads to search with, at least 1.
+             */
+            ParallelSearcher(TranspositionTable& table, unsigned int thread_count = 1) noexcept;
+
+            /**
+             * @brief       Searches a position for the best move.
+             *
+             * Same as Searcher::Search(), except that the node limit only counts the nodes of the
+             * main searcher, while the nodes reported to the callback and in the result are the
+             * nodes of all threads.
+             *
+             * @see         Searcher::Search()
+             */
+            Result Search(const BoardArea& board, const std::vector<std::uint64_t>& history,
+                          const Limits& limits, const std::atomic<bool>& stop,
+                          const IterationCallback& callback) noexcept;
+
+            /**
+             * @brief       Forgets the move ordering heuristics of all threads.
+             */
+            void ClearHeuristics(void) noexcept;
+
+            /**
+             * @brief       Changes the number of threads. Must not be called while searching.
+             *
+             * @param[in]   thread_count  The number of threads to search with, at least 1.
+             */
+            void SetThreadCount(unsigned int thread_count) noexcept;
+
+            /**
+             * @brief       Thread count getter.
+             *
+             * @return      The number of threads searched with.
+             */
+            unsigned int GetThreadCount(void) const noexcept
+            {
+                return static_cast<unsigned int>(searchers_.size());
+            }
+
+            /**
+             * @brief       Thread reports getter.
+             *
+             * @return      What each thread did in the last search, the main thread first.
+             */
+            const std::vector<ThreadReport>& GetThreadReports(void) const noexcept
+            {
+                return reports_;
+            }
+
+        private:
+            /**
+             * @brief       Sums the nodes searched by all threads so far.
+             *
+             * @return      The number of nodes.
+             */
+            std::uint64_t GetTotalNodes(void) const noexcept;
+
+            TranspositionTable& table_;                         ///< The shared table.
+            std::vector<std::unique_ptr<Searcher>> searchers_;  ///< One searcher per thread.
+            std::vector<ThreadReport> reports_;                 ///< Reports of the last search.
+        };
+    }  // namespace search
+}  // namespace raychess
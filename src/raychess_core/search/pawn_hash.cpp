@@ -0,0 +1,36 @@
+/**
+ * @file    pawn_hash.cpp
+ *
+ * @brief   Cache of the pawn structure evaluation.
+ *
+ * @section DESCRIPTION
+ *
+ * The pawn structure evaluation is cached by the position's pawn key.
+ */
+
+#include "pawn_hash.hpp"
+
+using namespace raychess;
+
+PawnHash::PawnHash(std::size_t size_kb) noexcept : mask_(0), hits_(0), misses_(0)
+{
+    std::size_t count = 1;
+    while (count * 2 * sizeof(Entry) <= size_kb * 1024) {
+        count *= 2;
+    }
+
+    entries_.resize(count);
+    mask_ = count - 1;
+    Clear();
+}
+
+void PawnHash::Clear(void) noexcept
+{
+    // A zeroed entry is the entry of a position without pawns, whose pawn structure is worth
+    // nothing, so even the empty cache holds only correct entries.
+    for (auto& entry : entries_) {
+        entry = {0, 0, 0};
+    }
+
+    ResetStatistics();
+}
@@ -0,0 +1,121 @@
+/**
+ * @file    pawn_hash.hpp
+ *
+ * @brief   Cache of the pawn structure evaluation.
+ *
+ * @section DESCRIPTION
+ *
+ * The pawn structure of a position rarely changes between the positions the search evaluates,
+ * as most moves aren't pawn moves, so its evaluation is cached by the position's pawn key.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace raychess
+{
+    /**
+     * @brief   Cache of the pawn structure evaluation, keyed by the pawn key.
+     *
+     * Entries are simply replaced on collisions. The cache isn't thread-safe, every search thread
+     * has a cache of its own, which keeps it small enough to stay in the processor's cache.
+     */
+    class PawnHash
+    {
+    public:
+        static constexpr std::size_t kDefaultSizeKb = 256;  ///< Default size of the cache.
+
+        /**
+         * @brief   Counters of the cache's use since the last reset.
+         */
+        struct Statistics
+        {
+            std::uint64_t hits;    ///< Probes that found their pawn structure.
+            std::uint64_t misses;  ///< Probes that didn't find their pawn structure.
+        };
+
+        /**
+         * @brief       Constructor.
+         *
+         * @param[in]   size_kb  The size of the cache in KB, rounded down to a power of two
+         * number of entries.
+         */
+        explicit PawnHash(std::size_t size_kb = kDefaultSizeKb) noexcept;
+
+        /**
+         * @brief       Discards all entries and resets the statistics.
+         */
+        void Clear(void) noexcept;
+
+        /**
+         * @brief       Looks up a pawn structure.
+         *
+         * @param[in]   key         The pawn key of the position.
+         * @param[out]  middlegame  The middlegame score of the pawn structure, if found.
+         * @param[out]  endgame     The endgame score of the pawn structure, if found.
+         *
+         * @return      True if the pawn structure was found, false otherwise.
+         */
+        bool Probe(std::uint64_t key, int& middlegame, int& endgame) noexcept
+        {
+            const Entry& entry = entries_[key & mask_];
+
+            if (entry.key == key) {
+                middlegame = entry.middlegame;
+                endgame = entry.endgame;
+                hits_++;
+                return true;
+            }
+
+            misses_++;
+            return false;
+        }
+
+        /**
+         * @brief       Stores the scores of a pawn structure.
+         *
+         * @param[in]   key         The pawn key of the position.
+         * @param[in]   middlegame  The middlegame score of the pawn structure.
+         * @param[in]   endgame     The endgame score of the pawn structure.
+         */
+        void Store(std::uint64_t key, int middlegame, int endgame) noexcept
+        {
+            entries_[key & mask_] = {key, middlegame, endgame};
+        }
+
+        /**
+         * @brief       Statistics getter.
+         *
+         * @return      The counters of the cache's use since the last reset.
+         */
+        Statistics GetStatistics(void) const noexcept { return {hits_, misses_}; }
+
+        /**
+         * @brief       Resets the counters of the cache's use.
+         */
+        void ResetStatistics(void) noexcept
+        {
+            hits_ = 0;
+            misses_ = 0;
+        }
+
+    private:
+        /**
+         * @brief   The cached scores of a pawn structure.
+         */
+        struct Entry
+        {
+            std::uint64_t key;        ///< The pawn key.
+            std::int32_t middlegame;  ///< The middlegame score, positive if white is better.
+            std::int32_t endgame;     ///< The endgame score, positive if white is better.
+        };
+
+        std::vector<Entry> entries_;  ///< The entries.
+        std::size_t mask_;            ///< Mask turning a key into an entry index.
+        std::uint64_t hits_;          ///< Probes that found their pawn structure.
+        std::uint64_t misses_;        ///< Probes that didn't find their pawn structure.
+    };
+}  // namespace raychess
@@ -0,0 +1,495 @@
+/**
+ * @file    searcher.cpp
+ *
+ * @brief   Alpha-beta search of the game tree.
+ *
+ * @section DESCRIPTION
+ *
+ * The searcher finds the best move of a position by iterative deepening principal variation
+ * search, with a quiescence search resolving captures at the leaves.
+ */
+
+#include "searcher.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+
+#include "evaluation.hpp"
+#include "move_generator.hpp"
+#include "move_picker.hpp"
+
+using namespace raychess;
+using namespace raychess::search;
+
+namespace
+{
+    constexpr std::uint64_t kCheckInterval = 1024;  ///< Nodes between checks of the limits.
+    constexpr int kHistoryLimit = 1 << 20;          ///< History score at which all are halved.
+
+    // Helper searchers skip iterations in cycles: each helper searches `size` consecutive depths
+    // and skips the next `size`, starting at its own phase of the cycle.
+    constexpr int kSkipPatternCount = 20;
+    constexpr int kSkipSize[kSkipPatternCount] = {1, 1, 2, 2, 2, 2, 3, 3, 3, 3,
+                                                  3, 3, 4, 4, 4, 4, 4, 4, 4, 4};
+    constexpr int kSkipPhase[kSkipPatternCount] = {0, 1, 0, 1, 2, 3, 0, 1, 2, 3,
+                                                   4, 5, 0, 1, 2, 3, 4, 5, 6, 7};
+
+    /**
+     * @brief       Converts a score to be stored in the transposition table.
+     *
+     * Mate scores count the plies to the mate from the root, but the table needs them counted from
+     * the stored position, which may be reached at another ply later.
+     *
+     * @param[in]   score  The score relative to the root.
+     * @param[in]   ply    The distance of the position from the root.
+     *
+     * @return      The score relative to the position.
+     */
+    int ScoreToTable(int score, int ply) noexcept
+    {
+        return score >= kMateBound ? score + ply : score <= -kMateBound ? score - ply : score;
+    }
+
+    /**
+     * @brief       Converts a score read from the transposition table, undoing ScoreToTable().
+     *
+     * @param[in]   score  The score relative to the position.
+     * @param[in]   ply    The distance of the position from the root.
+     *
+     * @return      The score relative to the root.
+     */
+    int ScoreFromTable(int score, int ply) noexcept
+    {
+        return score >= kMateBound ? score - ply : score <= -kMateBound ? score + ply : score;
+    }
+}  // namespace
+
+Searcher::Searcher(TranspositionTable& table, unsigned int thread_index) noexcept
+    : table_(table), thread_index_(thread_index), stop_(nullptr), nodes_(0), stopped_(false)
+{
+    ClearHeuristics();
+}
+
+Result Searcher::Search(const BoardArea& board, const std::vector<std::uint64_t>& history,
+                        const Limits& limits, const std::atomic<bool>& stop,
+                        const IterationCallback& callback) noexcept
+{
+    start_time_ = std::chrono::steady_clock::now();
+    limits_ = limits;
+    stop_ = &stop;
+    nodes_.store(0, std::memory_order_relaxed);
+    stopped_ = false;
+
+    board_.reset(new BoardArea(board));
+    keys_ = history;
+    keys_.reserve(history.size() + kMaxPly);
+    pawn_hash_.ResetStatistics();
+    table_statistics_ = TranspositionTable::Statistics();
+
+    // The killers are kept by ply, which means another position in a new search.
+    for (auto& killers : killers_) {
+        killers[0] = killers[1] = Move();
+    }
+
+    Result result;
+    const int max_depth = std::max(1, std::min(limits.depth, kMaxPly - 1));
+
+    for (int depth = 1; depth <= max_depth; depth++) {
+        if (SkipsIteration(depth) && depth < max_depth) {
+            continue;
+        }
+
+        const bool searched = SearchRoot(depth, result);
+
+        if (searched) {
+            result.depth = stopped_ ? result.depth : depth;
+            result.nodes = GetNodes();
+            result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() -
+                                                           start_time_)
+                                 .count();
+        }
+
+        if (stopped_ || !result.best_move.IsValid()) {
+            break;
+        }
+
+        if (callback) {
+            callback(result);
+        }
+
+        // The next iteration takes longer than all the previous ones together, so it's unlikely
+        // to finish when over half the time is gone already.
+        if (limits_.time_ms > 0 && result.seconds * 1000.0 * 2 > limits_.time_ms) {
+            break;
+        }
+
+        // There's no point in searching deeper once a forced mate is found.
+        if (IsMateScore(result.score) && kMateScore - std::abs(result.score) <= depth) {
+            break;
+        }
+    }
+
+    result.nodes = GetNodes();
+    result.seconds =
+        std::chrono::duration<double>(std::chrono::steady_clock::now() - start_time_).count();
+    return result;
+}
+
+void Searcher::ClearHeuristics(void) noexcept
+{
+    std::memset(history_, 0, sizeof(history_));
+    for (auto& killers : killers_) {
+        killers[0] = killers[1] = Move();
+    }
+}
+
+bool Searcher::SkipsIteration(int depth) const noexcept
+{
+    if (thread_index_ == 0) {
+        return false;
+    }
+
+    const int pattern = (thread_index_ - 1) % kSkipPatternCount;
+    return ((depth + kSkipPhase[pattern]) / kSkipSize[pattern]) % 2 != 0;
+}
+
+bool Searcher::SearchRoot(int depth, Result& result) noexcept
+{
+    const MoveGenerator generator(*board_);
+    MovePicker picker(*board_, generator, result.best_move, killers_[0],
+                      history_[static_cast<int>(board_->GetSideToMove())]);
+
+    int alpha = -kInfinity;
+    const int beta = kInfinity;
+    Move best_move;
+    bool searched = false;
+    pv_length_[0] = 0;
+    int move_count = 0;
+
+    for (Move move = picker.Next(); move.IsValid(); move = picker.Next()) {
+        move_count++;
+
+        BoardArea::UndoRecord undo;
+        MakeMove(move, undo);
+
+        int score;
+        if (move_count == 1) {
+            score = -SearchNode(depth - 1, 1, -beta, -alpha);
+        }
+        else {
+            score = -SearchNode(depth - 1, 1, -alpha - 1, -alpha);
+            if (score > alpha && !stopped_) {
+                score = -SearchNode(depth - 1, 1, -beta, -alpha);
+            }
+        }
+
+        UnmakeMove(undo);
+
+        if (stopped_) {
+            break;
+        }
+
+        searched = true;
+        if (score > alpha) {
+            alpha = score;
+            best_move = move;
+            UpdatePv(0, move);
+        }
+    }
+
+    if (move_count == 0) {
+        result.score = generator.IsInCheck() ? -kMateScore : 0;
+        return false;
+    }
+
+    // Moves of a stopped iteration are trusted if they were searched completely. The previous
+    // iteration's best move is searched first, so the result can only get better.
+    if (searched && best_move.IsValid()) {
+        result.best_move = best_move;
+        result.score = alpha;
+        result.pv.assign(pv_table_[0], pv_table_[0] + pv_length_[0]);
+
+        // Only some of the moves of a stopped iteration were searched, the others may be
+        // better still, so the score is only a lower bound.
+        const TranspositionTable::Bound bound =
+            stopped_ ? TranspositionTable::Bound::LOWER : TranspositionTable::Bound::EXACT;
+        if (table_.Store(board_->GetKey(), {best_move, ScoreToTable(alpha, 0), depth, bound})) {
+            table_statistics_.collisions++;
+        }
+    }
+
+    return searched;
+}
+
+int Searcher::SearchNode(int depth, int ply, int alpha, int beta) noexcept
+{
+    pv_length_[ply] = ply;
+
+    if (depth <= 0) {
+        return Quiesce(ply, alpha, beta);
+    }
+
+    CheckLimits();
+    if (stopped_) {
+        return 0;
+    }
+
+    if (IsDraw()) {
+        return 0;
+    }
+
+    if (ply >= kMaxPly - 1) {
+        return evaluation::Evaluate(*board_, &pawn_hash_);
+    }
+
+    // Neither side can do better than mating right away, so the window may be narrowed.
+    alpha = std::max(alpha, -kMateScore + ply);
+    beta = std::min(beta, kMateScore - ply - 1);
+    if (alpha >= beta) {
+        return alpha;
+    }
+
+    const bool pv_node = beta - alpha > 1;
+    const std::uint64_t key = board_->GetKey();
+
+    TranspositionTable::Data entry;
+    Move tt_move;
+    if (table_.Probe(key, entry)) {
+        table_statistics_.hits++;
+        tt_move = entry.move;
+
+        // Cutting off at PV nodes would cut the principal variation short.
+        if (!pv_node && entry.depth >= depth) {
+            const int score = ScoreFromTable(entry.score, ply);
+
+            if (entry.bound == TranspositionTable::Bound::EXACT ||
+                (entry.bound == TranspositionTable::Bound::LOWER && score >= beta) ||
+                (entry.bound == TranspositionTable::Bound::UPPER && score <= alpha)) {
+                return score;
+            }
+        }
+    }
+    else {
+        table_statistics_.misses++;
+    }
+
+    const MoveGenerator generator(*board_);
+
+    // Checks are searched deeper, so that the search doesn't stop just before a mate.
+    if (generator.IsInCheck()) {
+        depth++;
+    }
+
+    MovePicker picker(*board_, generator, tt_move, killers_[ply],
+                      history_[static_cast<int>(board_->GetSideToMove())]);
+
+    const int original_alpha = alpha;
+    int best_score = -kInfinity;
+    Move best_move;
+    int move_count = 0;
+
+    for (Move move = picker.Next(); move.IsValid(); move = picker.Next()) {
+        move_count++;
+
+        BoardArea::UndoRecord undo;
+        MakeMove(move, undo);
+
+        // The first move is expected to be the best, the others are only proven to be worse with
+        // a null window, unless they turn out not to be.
+        int score;
+        if (move_count == 1) {
+            score = -SearchNode(depth - 1, ply + 1, -beta, -alpha);
+        }
+        else {
+            score = -SearchNode(depth - 1, ply + 1, -alpha - 1, -alpha);
+            if (score > alpha && score < beta && !stopped_) {
+                score = -SearchNode(depth - 1, ply + 1, -beta, -alpha);
+            }
+        }
+
+        UnmakeMove(undo);
+
+        if (stopped_) {
+            return 0;
+        }
+
+        if (score > best_score) {
+            best_score = score;
+            best_move = move;
+
+            if (score > alpha) {
+                alpha = score;
+                UpdatePv(ply, move);
+
+                if (alpha >= beta) {
+                    if (!move.IsCapture() && !move.IsPromotion()) {
+                        RecordCutoff(move, depth, ply);
+                    }
+                    break;
+                }
+            }
+        }
+    }
+
+    if (move_count == 0) {
+        return generator.IsInCheck() ? -kMateScore + ply : 0;
+    }
+
+    const TranspositionTable::Bound bound =
+        best_score >= beta             ? TranspositionTable::Bound::LOWER
+        : best_score > original_alpha ? TranspositionTable::Bound::EXACT
+                                      : TranspositionTable::Bound::UPPER;
+    if (table_.Store(key, {bound == TranspositionTable::Bound::UPPER ? Move() : best_move,
+                           ScoreToTable(best_score, ply), depth, bound})) {
+        table_statistics_.collisions++;
+    }
+
+    return best_score;
+}
+
+int Searcher::Quiesce(int ply, int alpha, int beta) noexcept
+{
+    CheckLimits();
+    if (stopped_) {
+        return 0;
+    }
+
+    if (ply >= kMaxPly - 1) {
+        return evaluation::Evaluate(*board_, &pawn_hash_);
+    }
+
+    const MoveGenerator generator(*board_);
+    const bool in_check = generator.IsInCheck();
+    int best_score = -kInfinity;
+
+    // Unless in check, the side to move may decline all captures and keep the static score.
+    if (!in_check) {
+        best_score = evaluation::Evaluate(*board_, &pawn_hash_);
+        if (best_score >= beta) {
+            return best_score;
+        }
+        alpha = std::max(alpha, best_score);
+    }
+
+    // In check every evasion is searched, otherwise only the captures not losing material.
+    MovePicker picker(*board_, generator, history_[static_cast<int>(board_->GetSideToMove())]);
+    int move_count = 0;
+
+    for (Move move = picker.Next(); move.IsValid(); move = picker.Next()) {
+        move_count++;
+
+        BoardArea::UndoRecord undo;
+        MakeMove(move, undo);
+        const int score = -Quiesce(ply + 1, -beta, -alpha);
+        UnmakeMove(undo);
+
+        if (stopped_) {
+            return 0;
+        }
+
+        if (score > best_score) {
+            best_score = score;
+            if (score > alpha) {
+                alpha = score;
+                if (alpha >= beta) {
+                    break;
+                }
+            }
+        }
+    }
+
+    if (in_check && move_count == 0) {
+        return -kMateScore + ply;
+    }
+
+    return best_score;
+}
+
+void Searcher::RecordCutoff(Move move, int depth, int ply) noexcept
+{
+    if (killers_[ply][0] != move) {
+        killers_[ply][1] = killers_[ply][0];
+        killers_[ply][0] = move;
+    }
+
+    int& entry = history_[static_cast<int>(board_->GetSideToMove())][move.GetFrom()][move.GetTo()];
+    entry += depth * depth;
+
+    // Halving keeps the history below the evasion capture scores and lets it adapt to new
+    // positions.
+    if (entry >= kHistoryLimit) {
+        for (auto& colour : history_) {
+            for (auto& from : colour) {
+                for (auto& to : from) {
+                    to /= 2;
+                }
+            }
+        }
+    }
+}
+
+bool Searcher::IsDraw(void) const noexcept
+{
+    const int halfmove_clock = board_->GetHalfmoveClock();
+    if (halfmove_clock >= 100) {
+        return true;
+    }
+
+    // Only positions since the last capture or pawn move can repeat, and only those with the same
+    // side to move.
+    const std::uint64_t key = board_->GetKey();
+    const int count = static_cast<int>(keys_.size());
+    for (int i = count - 2; i >= 0 && i >= count - halfmove_clock; i -= 2) {
+        if (keys_[i] == key) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void Searcher::MakeMove(Move move, BoardArea::UndoRecord& undo) noexcept
+{
+    keys_.push_back(board_->GetKey());
+    board_->MakeMove(move, undo);
+    table_.Prefetch(board_->GetKey());
+
+    // Only this thread writes the count, so it needn't be incremented atomically, just stored
+    // so that other threads can read it.
+    nodes_.store(nodes_.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+}
+
+void Searcher::UnmakeMove(const BoardArea::UndoRecord& undo) noexcept
+{
+    board_->UnmakeMove(undo);
+    keys_.pop_back();
+}
+
+void Searcher::CheckLimits(void) noexcept
+{
+    const std::uint64_t nodes = GetNodes();
+    if (stopped_ || nodes % kCheckInterval != 0) {
+        return;
+    }
+
+    if (stop_->load(std::memory_order_relaxed) || (limits_.nodes > 0 && nodes >= limits_.nodes)) {
+        stopped_ = true;
+        return;
+    }
+
+    if (limits_.time_ms > 0) {
+        const auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now() - start_time_);
+        stopped_ = elapsed.count() >= limits_.time_ms;
+    }
+}
+
+void Searcher::UpdatePv(int ply, Move move) noexcept
+{
+    pv_table_[ply][ply] = move;
+    for (int i = ply + 1; i < pv_length_[ply + 1]; i++) {
+        pv_table_[ply][i] = pv_table_[ply + 1][i];
+    }
+    pv_length_[ply] = std::max(ply + 1, pv_length_[ply + 1]);
+}
@@ -0,0 +1,264 @@
+/**
+ * @file    searcher.hpp
+ *
+ * @brief   Alpha-beta search of the game tree.
+ *
+ * @section DESCRIPTION
+ *
+ * The searcher finds the best move of a position by iterative deepening principal variation
+ * search, with a quiescence search resolving captures at the leaves, so that the evaluation is
+ * only ever asked about quiet positions.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include "board_area.hpp"
+#include "move.hpp"
+#include "move_list.hpp"
+#include "pawn_hash.hpp"
+#include "transposition_table.hpp"
+
+namespace raychess
+{
+    namespace search
+    {
+        constexpr int kMaxPly = 128;                     ///< Deepest ply the search reaches.
+        constexpr int kInfinity = 32001;                 ///< Bound of all scores.
+        constexpr int kMateScore = 32000;                ///< Score of mating right now.
+        constexpr int kMateBound = kMateScore - kMaxPly;  ///< Scores beyond this are mates.
+
+        /**
+         * @brief   The limits of a search. A search without any limits runs until stopped.
+         */
+        struct Limits
+        {
+            int depth = kMaxPly - 1;   ///< Deepest iteration to search.
+            std::uint64_t nodes = 0;   ///< Most nodes to search, 0 for no limit.
+            std::int64_t time_ms = 0;  ///< Most milliseconds to search for, 0 for no limit.
+        };
+
+        /**
+         * @brief   The result of a search, or of a single iteration of it.
+         */
+        struct Result
+        {
+            Move best_move;           ///< The best move found, or "no move" if there is none.
+            int score = 0;            ///< The score of the best move, in centipawns.
+            int depth = 0;            ///< The depth of the last completed iteration.
+            std::uint64_t nodes = 0;  ///< Number of nodes searched.
+            double seconds = 0.0;     ///< Time the search took.
+            std::vector<Move> pv;     ///< The principal variation, starting with the best move.
+        };
+
+        /**
+         * @brief   Function called with the result of every completed iteration.
+         */
+        using IterationCallback = std::function<void(const Result&)>;
+
+        /**
+         * @brief       Checks whether a score means a mate, for either side.
+         *
+         * @param[in]   score  The score.
+         *
+         * @return      True if the score is a mate score, false otherwise.
+         */
+        constexpr bool IsMateScore(int score) noexcept
+        {
+            return score >= kMateBound || score <= -kMateBound;
+        }
+
+        /**
+         * @brief   Alpha-beta searcher of the game tree.
+         *
+         * The searcher keeps its own history table between searches, while its killer moves are
+         * forgotten at the start of each search as their plies no longer match. The
+         * transposition table is shared, possibly with other searchers running at the same time.
+         *
+         * Searchers other than the first of a parallel search are helpers: they skip some of the
+         * iterations depending on their index, so that the helpers spread over several depths
+         * and fill the table with results the others can use, instead of all searching the same
+         * tree in lockstep.
+         */
+        class Searcher
+        {
+        public:
+            /**
+             * @brief       Constructor.
+             *
+             * @param[in]   table         The transposition table to use.
+             * @param[in]   thread_index  Index of the searcher in a parallel search, 0 for the
+             * main searcher.
+             */
+            explicit Searcher(TranspositionTable& table, unsigned int thread_index = 0) noexcept;
+
+            /**
+             * @brief       Searches a position for the best move.
+             *
+             * @param[in]   board     The position to search. It is copied, the board itself is
+             * left alone.
+             * @param[in]   history   Keys of the positions of the game before this one, oldest
+             * first, used to detect repetitions.
+             * @param[in]   limits    The limits of the search.
+             * @param[in]   stop      Flag stopping the search as soon as it's set, from any thread.
+             * @param[in]   callback  Function called after every completed iteration, may be empty.
+             *
+             * @return      The result of the search.
+             */
+            Result Search(const BoardArea& board, const std::vector<std::uint64_t>& history,
+                          const Limits& limits, const std::atomic<bool>& stop,
+                          const IterationCallback& callback) noexcept;
+
+            /**
+             * @brief       Forgets the killer moves and the history table.
+             */
+            void ClearHeuristics(void) noexcept;
+
+            /**
+             * @brief       Nodes getter.
+             *
+             * Safe to call from other threads while searching.
+             *
+             * @return      Number of nodes searched by the last (or current) search.
+             */
+            std::uint64_t GetNodes(void) const noexcept
+            {
+                return nodes_.load(std::memory_order_relaxed);
+            }
+
+            /**
+             * @brief       Pawn hash statistics getter.
+             *
+             * @return      The use of the searcher's pawn hash during the last search.
+             */
+            PawnHash::Statistics GetPawnHashStatistics(void) const noexcept
+            {
+                return pawn_hash_.GetStatistics();
+            }
+
+            /**
+             * @brief       Transposition table statistics getter.
+             *
+             * @return      The searcher's use of the shared table during the last search.
+             */
+            const TranspositionTable::Statistics& GetTableStatistics(void) const noexcept
+            {
+                return table_statistics_;
+            }
+
+        private:
+            /**
+             * @brief       Checks whether a helper searcher skips an iteration.
+             *
+             * @param[in]   depth  The depth of the iteration.
+             *
+             * @return      True if the iteration is skipped, false otherwise.
+             */
+            bool SkipsIteration(int depth) const noexcept;
+
+            /**
+             * @brief       Searches the root moves to the given depth.
+             *
+             * @param[in]   depth   The depth of the iteration.
+             * @param[out]  result  The result to update with the best move found.
+             *
+             * @return      True if at least the first root move was searched completely.
+             */
+            bool SearchRoot(int depth, Result& result) noexcept;
+
+            /**
+             * @brief       Searches a node of the tree (negamax principal variation search).
+             *
+             * @param[in]   depth  The remaining depth.
+             * @param[in]   ply    The distance from the root.
+             * @param[in]   alpha  The lower bound of the window.
+             * @param[in]   beta   The upper bound of the window.
+             *
+             * @return      The score of the node from the side to move's point of view.
+             */
+            int SearchNode(int depth, int ply, int alpha, int beta) noexcept;
+
+            /**
+             * @brief       Searches captures (and check evasions) until the position is quiet.
+             *
+             * @param[in]   ply    The distance from the root.
+             * @param[in]   alpha  The lower bound of the window.
+             * @param[in]   beta   The upper bound of the window.
+             *
+             * @return      The score of the node from the side to move's point of view.
+             */
+            int Quiesce(int ply, int alpha, int beta) noexcept;
+
+            /**
+             * @brief       Records a quiet move which caused a beta cutoff.
+             *
+             * @param[in]   move   The move.
+             * @param[in]   depth  The remaining depth of the node.
+             * @param[in]   ply    The distance from the root.
+             */
+            void RecordCutoff(Move move, int depth, int ply) noexcept;
+
+            /**
+             * @brief       Checks whether the position repeated or the fifty move rule applies.
+             *
+             * @return      True if the position is a draw, false otherwise.
+             */
+            bool IsDraw(void) const noexcept;
+
+            /**
+             * @brief       Makes a move, keeping track of the position keys.
+             *
+             * @param[in]   move  The move to make.
+             * @param[out]  undo  The record to unmake the move with.
+             */
+            void MakeMove(Move move, BoardArea::UndoRecord& undo) noexcept;
+
+            /**
+             * @brief       Unmakes a move made by MakeMove().
+             *
+             * @param[in]   undo  The record MakeMove() filled in.
+             */
+            void UnmakeMove(const BoardArea::UndoRecord& undo) noexcept;
+
+            /**
+             * @brief       Checks the limits every so many nodes, setting stopped_ if reached.
+             */
+            void CheckLimits(void) noexcept;
+
+            /**
+             * @brief       Updates the principal variation of a ply with a new best move.
+             *
+             * @param[in]   ply   The distance from the root.
+             * @param[in]   move  The new best move.
+             */
+            void UpdatePv(int ply, Move move) noexcept;
+
+            TranspositionTable& table_;         ///< The transposition table.
+            unsigned int thread_index_;         ///< Index in a parallel search.
+            std::unique_ptr<BoardArea> board_;  ///< The searched position, moves are made on it.
+            std::vector<std::uint64_t> keys_;   ///< Keys of the positions before the current one.
+            PawnHash pawn_hash_;                ///< Cache of the pawn structure evaluation.
+
+            TranspositionTable::Statistics table_statistics_;  ///< Use of the table by this thread.
+
+            Limits limits_;                                     ///< Limits of the current search.
+            const std::atomic<bool>* stop_;                     ///< External stop flag.
+            std::chrono::steady_clock::time_point start_time_;  ///< Start of the current search.
+            std::atomic<std::uint64_t> nodes_;                  ///< Nodes searched.
+            bool stopped_;                                      ///< Whether the search stopped.
+
+            Move killers_[kMaxPly][2];  ///< Killer moves by ply.
+            int history_[BoardArea::kColourCount][bitboard::kSquareCount]
+                        [bitboard::kSquareCount];  ///< History by side, from and to square.
+
+            Move pv_table_[kMaxPly][kMaxPly];  ///< Principal variations of each ply.
+            int pv_length_[kMaxPly];           ///< Length of the principal variation of each ply.
+        };
+    }  // namespace search
+}  // namespace raychess
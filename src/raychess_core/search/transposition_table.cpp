@@ -0,0 +1,221 @@
+/**
+ * @file    transposition_table.cpp
+ *
+ * @brief   Transposition table shared by the search threads.
+ *
+ * @section DESCRIPTION
+ *
+ * The transposition table remembers the results of searched positions, keyed by their Zobrist
+ * keys.
+ */
+
+#include "transposition_table.hpp"
+
+#include <algorithm>
+#include <climits>
+#include <exception>
+#include <new>
+
+using namespace raychess;
+
+namespace
+{
+    // Layout of the data word of an entry.
+    constexpr int kScoreShift = 16;       ///< The score, a signed 16-bit number.
+    constexpr int kDepthShift = 32;       ///< The depth, a signed 8-bit number.
+    constexpr int kBoundShift = 40;       ///< The bound, 2 bits.
+    constexpr int kGenerationShift = 48;  ///< The generation of the search which stored it.
+
+    /**
+     * @brief       Packs a search result into the data word of an entry.
+     *
+     * @param[in]   data        The search result.
+     * @param[in]   generation  The generation of the current search.
+     *
+     * @return      The data word.
+     */
+    std::uint64_t Pack(const TranspositionTable::Data& data, std::uint8_t generation) noexcept
+    {
+        return static_cast<std::uint64_t>(data.move.GetRaw()) |
+               static_cast<std::uint64_t>(static_cast<std::uint16_t>(data.score)) << kScoreShift |
+               static_cast<std::uint64_t>(static_cast<std::uint8_t>(data.depth)) << kDepthShift |
+               static_cast<std::uint64_t>(data.bound) << kBoundShift |
+               static_cast<std::uint64_t>(generation) << kGenerationShift;
+    }
+
+    /**
+     * @brief       Unpacks the bound of an entry's data word.
+     *
+     * @param[in]   word  The data word.
+     *
+     * @return      The bound.
+     */
+    TranspositionTable::Bound UnpackBound(std::uint64_t word) noexcept
+    {
+        return static_cast<TranspositionTable::Bound>((word >> kBoundShift) & 0x3);
+    }
+
+    /**
+     * @brief       Unpacks the depth of an entry's data word.
+     *
+     * @param[in]   word  The data word.
+     *
+     * @return      The depth.
+     */
+    int UnpackDepth(std::uint64_t word) noexcept
+    {
+        return static_cast<std::int8_t>((word >> kDepthShift) & 0xff);
+    }
+
+    /**
+     * @brief       Unpacks the generation of an entry's data word.
+     *
+     * @param[in]   word  The data word.
+     *
+     * @return      The generation.
+     */
+    std::uint8_t UnpackGeneration(std::uint64_t word) noexcept
+    {
+        return static_cast<std::uint8_t>((word >> kGenerationShift) & 0xff);
+    }
+}  // namespace
+
+TranspositionTable::TranspositionTable(std::size_t size_mb) noexcept
+    : buckets_(nullptr), mask_(0), size_mb_(0), generation_(0)
+{
+    Resize(size_mb);
+}
+
+bool TranspositionTable::Resize(std::size_t size_mb) noexcept
+{
+    std::size_t count = 1;
+    while (count * 2 * sizeof(Bucket) <= size_mb * 1024 * 1024) {
+        count *= 2;
+    }
+
+    // The old table is freed first, so that its memory can be reused. If the new one can't be
+    // had, a table half the size is tried, down to a single bucket.
+    memory_.reset();
+    const std::size_t requested = count;
+    for (; count > 0; count /= 2) {
+        memory_.reset(new (std::nothrow) char[count * sizeof(Bucket) + alignof(Bucket)]);
+        if (memory_) {
+            break;
+        }
+    }
+    if (!memory_) {
+        // Not even a single bucket could be had, there's nothing left to fall back to.
+        std::terminate();
+    }
+
+    // Over-aligned types aren't guaranteed to be allocated aligned before C++17, so the buckets
+    // are placed into a slightly larger block by hand.
+    void* aligned = memory_.get();
+    std::size_t space = count * sizeof(Bucket) + alignof(Bucket);
+    buckets_ = static_cast<Bucket*>(std::align(alignof(Bucket), count * sizeof(Bucket), aligned,
+                                               space));
+    for (std::size_t i = 0; i < count; i++) {
+        new (&buckets_[i]) Bucket();
+    }
+
+    mask_ = count - 1;
+    size_mb_ = count == requested ? size_mb : count * sizeof(Bucket) / (1024 * 1024);
+    Clear();
+    return count == requested;
+}
+
+void TranspositionTable::Clear(void) noexcept
+{
+    for (std::size_t i = 0; i <= mask_; i++) {
+        for (auto& entry : buckets_[i].entries) {
+            entry.key.store(0, std::memory_order_relaxed);
+            entry.data.store(0, std::memory_order_relaxed);
+        }
+    }
+
+    generation_ = 0;
+}
+
+bool TranspositionTable::Probe(std::uint64_t key, Data& data) noexcept
+{
+    for (const auto& entry : buckets_[key & mask_].entries) {
+        const std::uint64_t word = entry.data.load(std::memory_order_relaxed);
+
+        if ((entry.key.load(std::memory_order_relaxed) ^ word) == key &&
+            UnpackBound(word) != Bound::NONE) {
+            data.move = Move(static_cast<std::uint16_t>(word & 0xffff));
+            data.score = static_cast<std::int16_t>((word >> kScoreShift) & 0xffff);
+            data.depth = UnpackDepth(word);
+            data.bound = UnpackBound(word);
+            return true;
+        }
+    }
+
+    return false;
+}
+
+bool TranspositionTable::Store(std::uint64_t key, const Data& data) noexcept
+{
+    Entry* victim = nullptr;
+    std::uint64_t victim_word = 0;
+    int victim_worth = INT_MAX;
+    bool same_position = false;
+
+    for (auto& entry : buckets_[key & mask_].entries) {
+        const std::uint64_t word = entry.data.load(std::memory_order_relaxed);
+
+        if (UnpackBound(word) == Bound::NONE) {
+            // An empty entry is worth nothing, but an entry of the same position still wins.
+            if (victim_worth > INT_MIN) {
+                victim = &entry;
+                victim_word = word;
+                victim_worth = INT_MIN;
+            }
+            continue;
+        }
+
+        if ((entry.key.load(std::memory_order_relaxed) ^ word) == key) {
+            victim = &entry;
+            victim_word = word;
+            same_position = true;
+            break;
+        }
+
+        // Each search the entry has survived counts as much as eight plies of depth.
+        const int age = static_cast<std::uint8_t>(generation_ - UnpackGeneration(word));
+        const int worth = UnpackDepth(word) - 8 * age;
+        if (worth < victim_worth) {
+            victim = &entry;
+            victim_word = word;
+            victim_worth = worth;
+        }
+    }
+
+    Data stored = data;
+    if (same_position && !stored.move.IsValid()) {
+        stored.move = Move(static_cast<std::uint16_t>(victim_word & 0xffff));
+    }
+
+    const std::uint64_t word = Pack(stored, generation_);
+    victim->key.store(key ^ word, std::memory_order_relaxed);
+    victim->data.store(word, std::memory_order_relaxed);
+    return !same_position && UnpackBound(victim_word) != Bound::NONE;
+}
+
+int TranspositionTable::GetHashfull(void) const noexcept
+{
+    const std::size_t sample = std::min<std::size_t>(mask_ + 1, 250);
+    int used = 0;
+
+    for (std::size_t i = 0; i < sample; i++) {
+        for (const auto& entry : buckets_[i].entries) {
+            const std::uint64_t word = entry.data.load(std::memory_order_relaxed);
+
+            if (UnpackBound(word) != Bound::NONE && UnpackGeneration(word) == generation_) {
+                used++;
+            }
+        }
+    }
+
+    return static_cast<int>(used * 1000 / (sample * kBucketSize));
+}
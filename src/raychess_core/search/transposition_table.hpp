@@ -0,0 +1,192 @@
+/**
+ * @file    transposition_table.hpp
+ *
+ * @brief   Transposition table shared by the search threads.
+ *
+ * @section DESCRIPTION
+ *
+ * The transposition table remembers the results of searched positions, keyed by their Zobrist
+ * keys, so that a position reached again (by another move order, in a later iteration or by
+ * another thread) needn't be searched again, or is at least searched best move first.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+#include "move.hpp"
+
+namespace raychess
+{
+    /**
+     * @brief   Transposition table shared by the search threads.
+     *
+     * Entries take 16 bytes, two 64-bit words: the data (best move, score, depth, bound and the
+     * search generation) and the position's key XORed with the data. Four entries make up a
+     * bucket the size of a cache line, and a position may be stored in any entry of its bucket.
+     *
+     * The table is accessed by any number of threads without locking. The words are written
+     * separately, so two threads may tear an entry, but a torn entry doesn't verify (its key XOR
+     * its data doesn't give the key of any position) and is treated as empty.
+     *
+     * When a bucket is full, the entry replaced is the one worth least, considering its depth and
+     * how many searches ago it was written. Entries of past searches are thus replaced first
+     * without the table ever having to be cleared between searches.
+     */
+    class TranspositionTable
+    {
+    public:
+        static constexpr std::size_t kDefaultSizeMb = 16;  ///< Default size of the table.
+
+        /**
+         * @brief       Structure representing what the stored score tells about the real score.
+         */
+        enum class Bound : std::uint8_t
+        {
+            NONE = 0,   ///< Nothing, used for empty entries.
+            UPPER = 1,  ///< The real score is at most the stored score (failed low).
+            LOWER = 2,  ///< The real score is at least the stored score (failed high).
+            EXACT = 3   ///< The stored score is the real score.
+        };
+
+        /**
+         * @brief   The search result stored for a position.
+         */
+        struct Data
+        {
+            Move move;    ///< The best move found, or "no move".
+            int score;    ///< The score, must fit in 16 bits.
+            int depth;    ///< The depth searched, must fit in 8 bits.
+            Bound bound;  ///< What the score tells about the real score.
+        };
+
+        /**
+         * @brief   Counters of the use of the table by a single thread.
+         *
+         * The table doesn't count anything itself, as counters shared by all search threads
+         * would be written at every node. Each searcher keeps its own.
+         */
+        struct Statistics
+        {
+            std::uint64_t hits = 0;        ///< Probes that found their position.
+            std::uint64_t misses = 0;      ///< Probes that didn't find their position.
+            std::uint64_t collisions = 0;  ///< Stores which replaced an entry of another position.
+        };
+
+        /**
+         * @brief       Constructor.
+         *
+         * @param[in]   size_mb  The size of the table in MB.
+         */
+        explicit TranspositionTable(std::size_t size_mb = kDefaultSizeMb) noexcept;
+
+        /**
+         * @brief       Changes the size of the table, discarding all its entries.
+         *
+         * The number of buckets is rounded down to a power of two, with at least one bucket. If
+         * the memory can't be allocated, the table is made as large as it can be instead. Must
+         * not be called while other threads use the table.
+         *
+         * @param[in]   size_mb  The new size of the table in MB.
+         *
+         * @return      True if the table got the size asked for, false if it is smaller.
+         */
+        bool Resize(std::size_t size_mb) noexcept;
+
+        /**
+         * @brief       Discards all entries.
+         *
+         * Must not be called while other threads use the table.
+         */
+        void Clear(void) noexcept;
+
+        /**
+         * @brief       Marks the start of a new search, ageing all entries written until now.
+         */
+        void NewSearch(void) noexcept { generation_++; }
+
+        /**
+         * @brief       Looks up a position.
+         *
+         * @param[in]   key   The key of the position.
+         * @param[out]  data  The stored search result, if found.
+         *
+         * @return      True if the position was found, false otherwise.
+         */
+        bool Probe(std::uint64_t key, Data& data) noexcept;
+
+        /**
+         * @brief       Stores the search result of a position.
+         *
+         * If the position has an entry already and the new result has no best move, the stored
+         * best move is kept.
+         *
+         * @param[in]   key   The key of the position.
+         * @param[in]   data  The search result.
+         *
+         * @return      True if an entry of another position was replaced, false otherwise.
+         */
+        bool Store(std::uint64_t key, const Data& data) noexcept;
+
+        /**
+         * @brief       Starts loading the bucket of a position into the cache.
+         *
+         * Issued as soon as the key of a position is known, the load overlaps with other work
+         * done before the position is probed.
+         *
+         * @param[in]   key  The key of the position.
+         */
+        void Prefetch(std::uint64_t key) const noexcept
+        {
+#if defined(__GNUC__) || defined(__clang__)
+            __builtin_prefetch(&buckets_[key & mask_]);
+#else
+            (void)key;
+#endif
+        }
+
+        /**
+         * @brief       Size getter.
+         *
+         * @return      The size of the table in MB, less than asked for if the memory couldn't be
+         * allocated.
+         */
+        std::size_t GetSizeMb(void) const noexcept { return size_mb_; }
+
+        /**
+         * @brief       Estimates how full the table is with entries of the current search.
+         *
+         * @return      The estimate in permille, from a sample of the table.
+         */
+        int GetHashfull(void) const noexcept;
+
+    private:
+        static constexpr int kBucketSize = 4;  ///< Number of entries in a bucket.
+
+        /**
+         * @brief   A single entry.
+         */
+        struct Entry
+        {
+            std::atomic<std::uint64_t> key;   ///< The position's key XORed with the data.
+            std::atomic<std::uint64_t> data;  ///< The packed search result.
+        };
+
+        /**
+         * @brief   The entries a position may be stored in, one cache line.
+         */
+        struct alignas(64) Bucket
+        {
+            Entry entries[kBucketSize];  ///< The entries.
+        };
+
+        std::unique_ptr<char[]> memory_;  ///< The memory holding the buckets, unaligned.
+        Bucket* buckets_;                 ///< The buckets, aligned to a cache line.
+        std::size_t mask_;                ///< Mask turning a key into a bucket index.
+        std::size_t size_mb_;             ///< The size of the table in MB.
+        std::uint8_t generation_;         ///< Number of the current search, wrapping around.
+    };
+}  // namespace raychess
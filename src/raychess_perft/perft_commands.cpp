@@ -0,0 +1,267 @@
+/**
+ * @file    perft_commands.cpp
+ *
+ * @brief   Commands of the perft executable.
+ *
+ * @section DESCRIPTION
+ *
+ * Counting the leaves of single positions, per root move or as a whole, and the suite of
+ * reference positions with their well known leaf counts.
+ */
+
+#include "perft_commands.hpp"
+
+#include <chrono>
+#include <cinttypes>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <vector>
+
+#include "board_area.hpp"
+#include "fen.hpp"
+#include "perft.hpp"
+
+using namespace raychess;
+
+namespace
+{
+    constexpr int kMaxReferenceDepth = 7;  ///< Deepest reference count of any suite position.
+
+    /**
+     * @brief   A reference position with its leaf counts.
+     */
+    struct ReferencePosition
+    {
+        const char* name;                             ///< Name of the position.
+        const char* fen;                              ///< The position, in FEN.
+        int default_depth;                            ///< Depth the suite runs by default.
+        std::uint64_t nodes[kMaxReferenceDepth + 1];  ///< Leaf counts by depth, 0 if unknown.
+    };
+
+    /**
+     * @brief   The reference positions.
+     *
+     * The positions and their counts are the ones collected on the Chess Programming Wiki, chosen
+     * to cover castling, en passant, promotions, checks and pins.
+     */
+    const ReferencePosition kSuite[] = {
+        {"start",
+         fen::kStartingPosition,
+         6,
+         {1, 20, 400, 8902, 197281, 4865609, 119060324, 3195901860ULL}},
+        {"kiwipete",
+         "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1",
+         5,
+         {1, 48, 2039, 97862, 4085603, 193690690, 8031647685ULL, 0}},
+        {"position 3",
+         "8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 1",
+         6,
+         {1, 14, 191, 2812, 43238, 674624, 11030083, 178633661}},
+        {"position 4",
+         "r3k2r/Pppp1ppp/1b3nbN/nP6/BBP1P3/q4N2/Pp1P2PP/R2Q1RK1 w kq - 0 1",
+         5,
+         {1, 6, 264, 9467, 422333, 15833292, 706045033, 0}},
+        {"position 4 mirrored",
+         "r2q1rk1/pP1p2pp/Q4n2/bbp1p3/Np6/1B3NBn/pPPP1PPP/R3K2R b KQ - 0 1",
+         5,
+         {1, 6, 264, 9467, 422333, 15833292, 706045033, 0}},
+        {"position 5",
+         "rnbq1k1r/pp1Pbppp/2p5/8/2B5/8/PPP1NnPP/RNBQK2R w KQ - 1 8",
+         5,
+         {1, 44, 1486, 62379, 2103487, 89941194, 0, 0}},
+        {"position 6",
+         "r4rk1/1pp1qppp/p1np1n2/2b1p1B1/2B1P1b1/P1NP1N2/1PP1QPPP/R4RK1 w - - 0 10",
+         5,
+         {1, 46, 2079, 89890, 3894594, 164075551, 6923051137ULL, 0}},
+    };
+
+    /**
+     * @brief       Loads a position, reporting a malformed FEN string.
+     *
+     * @param[out]  board  The board to set up.
+     * @param[in]   fen    The position, in FEN.
+     *
+     * @return      True if the position was loaded, false otherwise.
+     */
+    bool LoadPosition(BoardArea& board, const std::string& fen) noexcept
+    {
+        if (!fen::LoadPosition(board, fen)) {
+            std::fprintf(stderr, "Invalid FEN: %s\n", fen.c_str());
+            return false;
+        }
+        return true;
+    }
+
+    /**
+     * @brief       Computes the nodes per second of a run.
+     *
+     * @param[in]   nodes    The number of nodes counted.
+     * @param[in]   seconds  The duration of the run.
+     *
+     * @return      The nodes per second.
+     */
+    double NodesPerSecond(std::uint64_t nodes, double seconds) noexcept
+    {
+        return seconds > 0.0 ? static_cast<double>(nodes) / seconds : 0.0;
+    }
+
+    /**
+     * @brief       Counts the leaves below each root move and measures how long it takes.
+     *
+     * @param[in]   board    The position to count the leaves of.
+     * @param[in]   depth    The depth of the tree, in plies, at least 1.
+     * @param[in]   options  The threads and hash table to count with.
+     * @param[out]  seconds  The duration of the count.
+     *
+     * @return      The leaf count of every legal root move.
+     */
+    std::vector<perft::DivideEntry> TimeDivide(const BoardArea& board, int depth,
+                                               const perft_commands::Options& options,
+                                               double& seconds) noexcept
+    {
+        // The table is part of the measured time, clearing a large one isn't free.
+        const auto start = std::chrono::steady_clock::now();
+        std::unique_ptr<perft::PerftHash> hash;
+        if (options.hash_mb > 0) {
+            hash.reset(new perft::PerftHash(options.hash_mb));
+            if (hash->GetSizeMb() != options.hash_mb) {
+                std::printf("Not enough memory, the hash table is %zu MB\n", hash->GetSizeMb());
+            }
+        }
+        auto entries = perft::Divide(board, depth, options.thread_count, hash.get());
+        const auto end = std::chrono::steady_clock::now();
+
+        seconds = std::chrono::duration<double>(end - start).count();
+        return entries;
+    }
+
+    /**
+     * @brief       Checks the incremental board state all over the move tree, if asked to.
+     *
+     * @param[in,out]   board    The position to check the tree of.
+     * @param[in]       depth    The depth of the tree, in plies.
+     * @param[in]       options  Whether to check the state at all.
+     *
+     * @return      The number of times the state differed from the one computed from scratch, 0
+     * if it always matched or wasn't checked.
+     */
+    std::uint64_t VerifyState(BoardArea& board, int depth,
+                              const perft_commands::Options& options) noexcept
+    {
+        return options.verify ? perft::CountMismatches(board, depth) : 0;
+    }
+
+    /**
+     * @brief       Sums up the leaf counts of all root moves.
+     *
+     * @param[in]   entries  The leaf counts of the root moves.
+     *
+     * @return      The number of leaves.
+     */
+    std::uint64_t SumNodes(const std::vector<perft::DivideEntry>& entries) noexcept
+    {
+        std::uint64_t nodes = 0;
+        for (const auto& entry : entries) {
+            nodes += entry.nodes;
+        }
+        return nodes;
+    }
+}  // namespace
+
+int perft_commands::RunPerft(const std::string& fen, int depth, const Options& options) noexcept
+{
+    BoardArea board(8, 8);
+
+    if (!LoadPosition(board, fen)) {
+        return 1;
+    }
+
+    double seconds = 0.0;
+    const std::uint64_t nodes =
+        depth > 0 ? SumNodes(TimeDivide(board, depth, options, seconds)) : 1;
+
+    std::printf("Depth %d: %" PRIu64 " nodes in %.3f s (%.0f nps)\n", depth, nodes, seconds,
+                NodesPerSecond(nodes, seconds));
+
+    const std::uint64_t mismatches = VerifyState(board, depth, options);
+    if (options.verify) {
+        std::printf("State mismatches: %" PRIu64 "\n", mismatches);
+    }
+    return mismatches == 0 ? 0 : 1;
+}
+
+int perft_commands::RunDivide(const std::string& fen, int depth, const Options& options) noexcept
+{
+    BoardArea board(8, 8);
+
+    if (!LoadPosition(board, fen) || depth < 1) {
+        return 1;
+    }
+
+    double seconds;
+    const auto entries = TimeDivide(board, depth, options, seconds);
+    for (const auto& entry : entries) {
+        std::printf("%s: %" PRIu64 "\n", entry.move.ToString().c_str(), entry.nodes);
+    }
+
+    const std::uint64_t nodes = SumNodes(entries);
+    std::printf("\nMoves: %zu\nNodes: %" PRIu64 " in %.3f s (%.0f nps)\n", entries.size(), nodes,
+                seconds, NodesPerSecond(nodes, seconds));
+
+    const std::uint64_t mismatches = VerifyState(board, depth, options);
+    if (options.verify) {
+        std::printf("State mismatches: %" PRIu64 "\n", mismatches);
+    }
+    return mismatches == 0 ? 0 : 1;
+}
+
+int perft_commands::RunSuite(int max_depth, const Options& options) noexcept
+{
+    BoardArea board(8, 8);
+    std::uint64_t total_nodes = 0;
+    double total_seconds = 0.0;
+    int failures = 0;
+
+    std::printf("Counting on %u thread(s), hash table %zu MB%s\n\n", options.thread_count,
+                options.hash_mb, options.verify ? ", checking the board state" : "");
+
+    for (const auto& position : kSuite) {
+        int depth = (max_depth > 0 ? max_depth : position.default_depth);
+
+        // Don't go deeper than the known counts of the position.
+        while (depth > 1 && (depth > kMaxReferenceDepth || position.nodes[depth] == 0)) {
+            depth--;
+        }
+
+        if (!LoadPosition(board, position.fen)) {
+            failures++;
+            continue;
+        }
+
+        double seconds;
+        const std::uint64_t nodes = SumNodes(TimeDivide(board, depth, options, seconds));
+        const std::uint64_t mismatches = VerifyState(board, depth, options);
+        const bool passed = nodes == position.nodes[depth] && mismatches == 0;
+
+        std::printf("%-20s depth %d: %12" PRIu64 " nodes %8.3f s %12.0f nps  %s\n", position.name,
+                    depth, nodes, seconds, NodesPerSecond(nodes, seconds),
+                    passed ? "ok" : "FAILED");
+        if (nodes != position.nodes[depth]) {
+            std::printf("%-20s expected %" PRIu64 " nodes\n", "", position.nodes[depth]);
+        }
+        if (mismatches != 0) {
+            std::printf("%-20s %" PRIu64 " state mismatches\n", "", mismatches);
+        }
+        if (!passed) {
+            failures++;
+        }
+
+        total_nodes += nodes;
+        total_seconds += seconds;
+    }
+
+    std::printf("\nTotal: %" PRIu64 " nodes in %.3f s (%.0f nps), %d failed\n", total_nodes,
+                total_seconds, NodesPerSecond(total_nodes, total_seconds), failures);
+    return failures == 0 ? 0 : 1;
+}
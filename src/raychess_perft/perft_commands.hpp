@@ -0,0 +1,65 @@
+/**
+ * @file    perft_commands.hpp
+ *
+ * @brief   Commands of the perft executable.
+ *
+ * @section DESCRIPTION
+ *
+ * Declares the commands runnable by the perft executable. Each command prints its own results to
+ * the standard output. With Options::verify set, each also checks the Zobrist keys, scores and
+ * phase BoardArea keeps up to date against the ones computed from scratch, all over the tree.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+namespace raychess
+{
+    namespace perft_commands
+    {
+        /**
+         * @brief   Settings shared by all commands.
+         */
+        struct Options
+        {
+            unsigned int thread_count = 1;  ///< Number of threads the root moves are split between.
+            std::size_t hash_mb = 0;        ///< Size of the perft hash table in MB, 0 for none.
+            bool verify = false;            ///< Whether to check the incremental board state too.
+        };
+
+        /**
+         * @brief       Counts the leaves of a position's move tree and reports the speed.
+         *
+         * @param[in]   fen      The position, in FEN.
+         * @param[in]   depth    The depth of the tree, in plies.
+         * @param[in]   options  The threads and hash table to count with.
+         *
+         * @return      Zero on success, non-zero otherwise.
+         */
+        int RunPerft(const std::string& fen, int depth, const Options& options) noexcept;
+
+        /**
+         * @brief       Counts the leaves of a position's move tree below each root move.
+         *
+         * @param[in]   fen      The position, in FEN.
+         * @param[in]   depth    The depth of the tree, in plies.
+         * @param[in]   options  The threads and hash table to count with.
+         *
+         * @return      Zero on success, non-zero otherwise.
+         */
+        int RunDivide(const std::string& fen, int depth, const Options& options) noexcept;
+
+        /**
+         * @brief       Runs the suite of reference positions and checks their leaf counts.
+         *
+         * @param[in]   max_depth  The deepest tree to count, 0 for each position's default.
+         * @param[in]   options    The threads and hash table to count with.
+         *
+         * @return      Zero if all counts match, and the board state wherever it was checked,
+         * non-zero otherwise.
+         */
+        int RunSuite(int max_depth, const Options& options) noexcept;
+    }  // namespace perft_commands
+}  // namespace raychess
@@ -0,0 +1,119 @@
+/**
+ * @file    perft_main.cpp
+ *
+ * @brief   Entry point of the perft executable.
+ *
+ * @section DESCRIPTION
+ *
+ * Runs one of the perft commands, selected by the first argument.
+ */
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+#include "fen.hpp"
+#include "perft_commands.hpp"
+
+using namespace raychess;
+
+namespace
+{
+    /**
+     * @brief       Prints the usage of the executable.
+     *
+     * @param[in]   program  Name of the executable.
+     */
+    void PrintUsage(const char* program) noexcept
+    {
+        std::printf("Usage: %s [options] <command> [arguments]\n\n", program);
+        std::printf("Options:\n");
+        std::printf("  --threads <count>       Split the root moves between threads (default 1)\n");
+        std::printf("  --hash <MB>             Share a perft hash table of the given size\n");
+        std::printf("  --verify                Check the incrementally updated keys and scores\n\n");
+        std::printf("Commands:\n");
+        std::printf("  perft <depth> [fen]     Count the leaves of the move tree\n");
+        std::printf("  divide <depth> [fen]    Count the leaves below each root move\n");
+        std::printf("  suite [depth]           Check the counts of the reference positions\n\n");
+        std::printf("The position defaults to the starting position.\n");
+    }
+
+    /**
+     * @brief       Joins the arguments making up a FEN string.
+     *
+     * A FEN string contains spaces, so it may be passed either quoted or as separate arguments.
+     *
+     * @param[in]   argc   Number of arguments.
+     * @param[in]   argv   The arguments.
+     * @param[in]   first  Index of the first argument of the FEN string.
+     *
+     * @return      The FEN string, or the starting position if there are no arguments left.
+     */
+    std::string JoinFen(int argc, char* argv[], int first) noexcept
+    {
+        if (first >= argc) {
+            return fen::kStartingPosition;
+        }
+
+        std::string fen = argv[first];
+        for (int i = first + 1; i < argc; i++) {
+            fen += ' ';
+            fen += argv[i];
+        }
+        return fen;
+    }
+}  // namespace
+
+int main(int argc, char* argv[])
+{
+    perft_commands::Options options;
+    int command = 1;
+
+    for (; command + 1 < argc && std::strncmp(argv[command], "--", 2) == 0; command++) {
+        if (std::strcmp(argv[command], "--verify") == 0) {
+            options.verify = true;
+        }
+        else if (std::strcmp(argv[command], "--threads") == 0) {
+            const int thread_count = std::atoi(argv[++command]);
+            options.thread_count = static_cast<unsigned int>(std::max(1, thread_count));
+        }
+        else if (std::strcmp(argv[command], "--hash") == 0) {
+            const int hash_mb = std::atoi(argv[++command]);
+            options.hash_mb = static_cast<std::size_t>(std::max(0, hash_mb));
+        }
+        else {
+            PrintUsage(argv[0]);
+            return EXIT_FAILURE;
+        }
+    }
+
+    if (command >= argc) {
+        PrintUsage(argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    if (std::strcmp(argv[command], "suite") == 0) {
+        const int depth = (command + 1 < argc ? std::atoi(argv[command + 1]) : 0);
+        return perft_commands::RunSuite(depth, options) == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+    }
+
+    if (command + 1 < argc && std::strcmp(argv[command], "perft") == 0) {
+        const int depth = std::atoi(argv[command + 1]);
+        return perft_commands::RunPerft(JoinFen(argc, argv, command + 2), depth, options) == 0
+                   ? EXIT_SUCCESS
+                   : EXIT_FAILURE;
+    }
+
+    if (command + 1 < argc && std::strcmp(argv[command], "divide") == 0) {
+        const int depth = std::atoi(argv[command + 1]);
+        return perft_commands::RunDivide(JoinFen(argc, argv, command + 2), depth, options) == 0
+                   ? EXIT_SUCCESS
+                   : EXIT_FAILURE;
+    }
+
+    PrintUsage(argv[0]);
+    return EXIT_FAILURE;
+}
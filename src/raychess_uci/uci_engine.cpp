@@ -0,0 +1,366 @@
+/**
+ * @file    uci_engine.cpp
+ *
+ * @brief   The engine side of the Universal Chess Interface.
+ *
+ * @section DESCRIPTION
+ *
+ * Reads UCI commands one line at a time and answers them on the standard output. Searches run on
+ * a thread of their own, so commands keep being read while the engine thinks and "stop" reaches
+ * the search right away.
+ */
+
+#include "uci_engine.hpp"
+
+#include <algorithm>
+#include <cctype>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <sstream>
+
+#include "fen.hpp"
+#include "move_list.hpp"
+#include "transposition_table.hpp"
+
+using namespace raychess;
+
+namespace
+{
+    constexpr std::int64_t kMoveOverheadMs = 30;  ///< Time kept back for the communication.
+    constexpr int kMovesToGo = 30;                ///< Moves the clock is shared out between.
+
+    /**
+     * @brief       Splits a command into its words.
+     *
+     * @param[in]   line  The command line.
+     *
+     * @return      The words, without the white space between them.
+     */
+    std::vector<std::string> Split(const std::string& line) noexcept
+    {
+        std::vector<std::string> tokens;
+        std::istringstream stream(line);
+        for (std::string token; stream >> token;) {
+            tokens.push_back(token);
+        }
+        return tokens;
+    }
+
+    /**
+     * @brief       Compares two words, ignoring case as UCI does for option names.
+     *
+     * @param[in]   lhs  The first word.
+     * @param[in]   rhs  The second word.
+     *
+     * @return      True if the words are the same but for case, false otherwise.
+     */
+    bool EqualsIgnoringCase(const std::string& lhs, const std::string& rhs) noexcept
+    {
+        return lhs.size() == rhs.size() &&
+               std::equal(lhs.begin(), lhs.end(), rhs.begin(), [](char a, char b) {
+                   return std::tolower(static_cast<unsigned char>(a)) ==
+                          std::tolower(static_cast<unsigned char>(b));
+               });
+    }
+
+    /**
+     * @brief       Converts a score to its UCI form.
+     *
+     * @param[in]   score  The score, in centipawns or a mate score.
+     *
+     * @return      "cp" followed by the centipawns, or "mate" followed by the moves until mate,
+     * negative if the side to move is getting mated.
+     */
+    std::string FormatScore(int score) noexcept
+    {
+        if (!search::IsMateScore(score)) {
+            return "cp " + std::to_string(score);
+        }
+
+        const int moves = score > 0 ? (search::kMateScore - score + 1) / 2
+                                    : -(search::kMateScore + score) / 2;
+        return "mate " + std::to_string(moves);
+    }
+}  // namespace
+
+search::Limits uci::GetLimits(const GoOptions& options) noexcept
+{
+    search::Limits limits;
+    if (options.depth > 0) {
+        limits.depth = std::min(options.depth, search::kMaxPly - 1);
+    }
+    limits.nodes = options.nodes;
+
+    if (options.infinite) {
+        return limits;
+    }
+
+    if (options.move_time_ms > 0) {
+        limits.time_ms = std::max<std::int64_t>(1, options.move_time_ms - kMoveOverheadMs);
+    }
+    else if (options.clock) {
+        const std::int64_t usable = std::max<std::int64_t>(1, options.time_ms - kMoveOverheadMs);
+        const int moves = options.moves_to_go > 0 ? std::min(options.moves_to_go, kMovesToGo)
+                                                  : kMovesToGo;
+        limits.time_ms = std::min(usable, usable / moves + options.increment_ms * 3 / 4);
+        limits.time_ms = std::max<std::int64_t>(1, limits.time_ms);
+    }
+    return limits;
+}
+
+uci::Engine::Engine(void) noexcept : infinite_(false), held_back_(false) {}
+
+void uci::Engine::Run(void) noexcept
+{
+    for (std::string line; std::getline(std::cin, line);) {
+        if (!HandleCommand(line)) {
+            return;
+        }
+    }
+
+    // The input ended without "quit", e.g. because the GUI went away.
+    game_.StopSearch();
+}
+
+bool uci::Engine::HandleCommand(const std::string& line) noexcept
+{
+    const std::vector<std::string> tokens = Split(line);
+    if (tokens.empty()) {
+        return true;
+    }
+
+    const std::string& command = tokens[0];
+    if (command == "uci") {
+        HandleUci();
+    }
+    else if (command == "isready") {
+        Send("readyok");
+    }
+    else if (command == "setoption") {
+        HandleSetOption(tokens);
+    }
+    else if (command == "ucinewgame") {
+        game_.ClearHash();
+    }
+    else if (command == "position") {
+        HandlePosition(tokens);
+    }
+    else if (command == "go") {
+        HandleGo(tokens);
+    }
+    else if (command == "stop") {
+        HandleStop();
+    }
+    else if (command == "quit") {
+        HandleStop();
+        return false;
+    }
+    return true;
+}
+
+void uci::Engine::HandleUci(void) noexcept
+{
+    Send("id name RayChess 0.1");
+    Send("id author Martin Cagas");
+    Send("option name Hash type spin default " +
+         std::to_string(TranspositionTable::kDefaultSizeMb) + " min 1 max " +
+         std::to_string(kMaxHashMb));
+    Send("option name Threads type spin default 1 min 1 max " + std::to_string(kMaxThreads));
+    Send("uciok");
+}
+
+void uci::Engine::HandleSetOption(const std::vector<std::string>& tokens) noexcept
+{
+    // Option names may contain spaces: "setoption name <name> value <value>".
+    std::string name;
+    std::string value;
+    std::string* field = nullptr;
+    for (std::size_t i = 1; i < tokens.size(); i++) {
+        if (tokens[i] == "name") {
+            field = &name;
+        }
+        else if (tokens[i] == "value") {
+            field = &value;
+        }
+        else if (field != nullptr) {
+            *field += (field->empty() ? "" : " ") + tokens[i];
+        }
+    }
+
+    if (EqualsIgnoringCase(name, "Hash")) {
+        const long long hash_mb = std::atoll(value.c_str());
+        if (!game_.SetHashSize(static_cast<std::size_t>(std::min<long long>(
+                std::max(1LL, hash_mb), static_cast<long long>(kMaxHashMb))))) {
+            Send("info string not enough memory, hash is " +
+                 std::to_string(game_.GetHashSize()) + " MB");
+        }
+    }
+    else if (EqualsIgnoringCase(name, "Threads")) {
+        const long long thread_count = std::atoll(value.c_str());
+        game_.SetThreadCount(static_cast<unsigned int>(
+            std::min<long long>(std::max(1LL, thread_count), static_cast<long long>(kMaxThreads))));
+    }
+    else {
+        Send("info string unknown option " + name);
+    }
+}
+
+void uci::Engine::HandlePosition(const std::vector<std::string>& tokens) noexcept
+{
+    std::size_t index = 1;
+    std::string fen;
+    if (index < tokens.size() && tokens[index] == "startpos") {
+        fen = fen::kStartingPosition;
+        index++;
+    }
+    else if (index < tokens.size() && tokens[index] == "fen") {
+        for (index++; index < tokens.size() && tokens[index] != "moves"; index++) {
+            fen += (fen.empty() ? "" : " ") + tokens[index];
+        }
+    }
+
+    if (!game_.LoadPosition(fen)) {
+        Send("info string invalid position");
+        return;
+    }
+
+    if (index < tokens.size() && tokens[index] == "moves") {
+        index++;
+    }
+
+    // Moves are matched against the legal moves, which also tells castling and promotions apart.
+    for (; index < tokens.size(); index++) {
+        MoveList moves;
+        game_.GetLegalMoves(moves);
+
+        const auto move = std::find_if(moves.begin(), moves.end(), [&](Move candidate) {
+            return candidate.ToString() == tokens[index];
+        });
+        if (move == moves.end()) {
+            Send("info string illegal move " + tokens[index]);
+            return;
+        }
+        game_.MakeMove(*move);
+    }
+}
+
+void uci::Engine::HandleGo(const std::vector<std::string>& tokens) noexcept
+{
+    const bool white = game_.GetBoard().GetSideToMove() == PieceBase::PieceColour::WHITE;
+
+    GoOptions options;
+    for (std::size_t i = 1; i < tokens.size(); i++) {
+        const std::string& token = tokens[i];
+        if (token == "infinite") {
+            options.infinite = true;
+            continue;
+        }
+        if (i + 1 >= tokens.size()) {
+            break;
+        }
+
+        const char* value = tokens[i + 1].c_str();
+        if (token == (white ? "wtime" : "btime")) {
+            options.clock = true;
+            options.time_ms = std::atoll(value);
+        }
+        else if (token == (white ? "winc" : "binc")) {
+            options.increment_ms = std::atoll(value);
+        }
+        else if (token == "movestogo") {
+            options.moves_to_go = std::atoi(value);
+        }
+        else if (token == "movetime") {
+            options.move_time_ms = std::atoll(value);
+        }
+        else if (token == "depth") {
+            options.depth = std::atoi(value);
+        }
+        else if (token == "nodes") {
+            options.nodes = std::strtoull(value, nullptr, 10);
+        }
+        else {
+            continue;
+        }
+        i++;
+    }
+
+    game_.StopSearch();
+    {
+        std::lock_guard<std::mutex> lock(output_mutex_);
+        infinite_ = options.infinite;
+        held_back_ = false;
+    }
+
+    game_.StartSearch(
+        GetLimits(options), [this](const search::Result& result) { SendInfo(result); },
+        [this](const search::Result& result) { FinishSearch(result); });
+}
+
+void uci::Engine::HandleStop(void) noexcept
+{
+    {
+        std::lock_guard<std::mutex> lock(output_mutex_);
+        infinite_ = false;
+    }
+
+    // The search notices the stop within a few thousand nodes and sends its best move before
+    // StopSearch() returns.
+    game_.StopSearch();
+
+    search::Result result;
+    {
+        std::lock_guard<std::mutex> lock(output_mutex_);
+        if (!held_back_) {
+            return;
+        }
+        held_back_ = false;
+        result = held_;
+    }
+    SendBestMove(result);
+}
+
+void uci::Engine::Send(const std::string& line) noexcept
+{
+    std::lock_guard<std::mutex> lock(output_mutex_);
+    std::printf("%s\n", line.c_str());
+    std::fflush(stdout);
+}
+
+void uci::Engine::SendInfo(const search::Result& result) noexcept
+{
+    const std::int64_t time_ms = static_cast<std::int64_t>(result.seconds * 1000.0);
+    const std::uint64_t nps =
+        result.seconds > 0.0 ? static_cast<std::uint64_t>(result.nodes / result.seconds) : 0;
+
+    std::string line = "info depth " + std::to_string(result.depth) + " score " +
+                       FormatScore(result.score) + " nodes " + std::to_string(result.nodes) +
+                       " nps " + std::to_string(nps) + " time " + std::to_string(time_ms) + " pv";
+    for (const Move move : result.pv) {
+        line += " " + move.ToString();
+    }
+    Send(line);
+}
+
+void uci::Engine::FinishSearch(const search::Result& result) noexcept
+{
+    {
+        std::lock_guard<std::mutex> lock(output_mutex_);
+        if (infinite_) {
+            held_back_ = true;
+            held_ = result;
+            return;
+        }
+    }
+    SendBestMove(result);
+}
+
+void uci::Engine::SendBestMove(const search::Result& result) noexcept
+{
+    std::string line = "bestmove " + result.best_move.ToString();
+    if (result.pv.size() > 1) {
+        line += " ponder " + result.pv[1].ToString();
+    }
+    Send(line);
+}
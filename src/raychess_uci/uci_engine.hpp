@@ -0,0 +1,158 @@
+/**
+ * @file    uci_engine.hpp
+ *
+ * @brief   The engine side of the Universal Chess Interface.
+ *
+ * @section DESCRIPTION
+ *
+ * Reads UCI commands one line at a time and answers them on the standard output. Searches run on
+ * a thread of their own, so commands keep being read while the engine thinks and "stop" reaches
+ * the search right away.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "game.hpp"
+#include "searcher.hpp"
+
+namespace raychess
+{
+    namespace uci
+    {
+        constexpr std::size_t kMaxHashMb = 4096;   ///< Largest transposition table, in MB.
+        constexpr unsigned int kMaxThreads = 256;  ///< Most threads to search with.
+
+        /**
+         * @brief   The clock and limits of a "go" command.
+         */
+        struct GoOptions
+        {
+            bool clock = false;             ///< Whether the side to move's clock was given.
+            std::int64_t time_ms = 0;       ///< Time left on the clock of the side to move.
+            std::int64_t increment_ms = 0;  ///< Increment per move of the side to move.
+            int moves_to_go = 0;            ///< Moves until the next time control, 0 if none.
+            std::int64_t move_time_ms = 0;  ///< Exact time to search for, 0 if not given.
+            int depth = 0;                  ///< Deepest iteration, 0 for no limit.
+            std::uint64_t nodes = 0;        ///< Most nodes to search, 0 for no limit.
+            bool infinite = false;          ///< Whether to search until told to stop.
+        };
+
+        /**
+         * @brief       Works out the limits of a search from the options of a "go" command.
+         *
+         * A fixed move time is used as is, less a safety margin for the communication. Otherwise
+         * the clock is shared out between the moves until the next time control, or an
+         * estimate of the moves left in the game, and most of the increment is added. A clock
+         * which has run out still gives the shortest search rather than none.
+         *
+         * @param[in]   options  The options of the command.
+         *
+         * @return      The limits of the search.
+         */
+        search::Limits GetLimits(const GoOptions& options) noexcept;
+
+        /**
+         * @brief   Answers UCI commands with a game of its own.
+         */
+        class Engine
+        {
+        public:
+            /**
+             * @brief       Constructor. The engine starts in the starting position.
+             */
+            Engine(void) noexcept;
+
+            /**
+             * @brief       Reads and answers commands from the standard input until "quit" or
+             * the end of the input.
+             */
+            void Run(void) noexcept;
+
+            /**
+             * @brief       Answers a single command.
+             *
+             * @param[in]   line  The command line, without the line break.
+             *
+             * @return      False if the command was "quit", true otherwise.
+             */
+            bool HandleCommand(const std::string& line) noexcept;
+
+        private:
+            /**
+             * @brief       Answers "uci" with the name of the engine and its options.
+             */
+            void HandleUci(void) noexcept;
+
+            /**
+             * @brief       Answers "setoption", changing the hash size or the thread count.
+             *
+             * @param[in]   tokens  The words of the command.
+             */
+            void HandleSetOption(const std::vector<std::string>& tokens) noexcept;
+
+            /**
+             * @brief       Answers "position", setting up a position and playing moves on it.
+             *
+             * @param[in]   tokens  The words of the command.
+             */
+            void HandlePosition(const std::vector<std::string>& tokens) noexcept;
+
+            /**
+             * @brief       Answers "go", starting a search in the background.
+             *
+             * @param[in]   tokens  The words of the command.
+             */
+            void HandleGo(const std::vector<std::string>& tokens) noexcept;
+
+            /**
+             * @brief       Answers "stop", ending the search and sending its best move.
+             */
+            void HandleStop(void) noexcept;
+
+            /**
+             * @brief       Sends a line to the standard output, flushing it.
+             *
+             * May be called from the search thread as well as from the one reading commands.
+             *
+             * @param[in]   line  The line, without the line break.
+             */
+            void Send(const std::string& line) noexcept;
+
+            /**
+             * @brief       Sends the "info" line of a completed iteration.
+             *
+             * @param[in]   result  The result of the iteration.
+             */
+            void SendInfo(const search::Result& result) noexcept;
+
+            /**
+             * @brief       Sends the best move of a finished search.
+             *
+             * In an infinite search, the move is held back until "stop" arrives, as UCI asks.
+             *
+             * @param[in]   result  The final result of the search.
+             */
+            void FinishSearch(const search::Result& result) noexcept;
+
+            /**
+             * @brief       Sends the best move of a search, and the reply it expects if known.
+             *
+             * @param[in]   result  The final result of the search.
+             */
+            void SendBestMove(const search::Result& result) noexcept;
+
+            Game game_;  ///< The game holding the position and the computer.
+
+            std::mutex output_mutex_;  ///< Guards the output and the fields below.
+            bool infinite_;            ///< Whether the search runs until "stop".
+            bool held_back_;           ///< Whether a best move waits for "stop".
+            search::Result held_;      ///< The result whose best move waits for "stop".
+        };
+    }  // namespace uci
+}  // namespace raychess
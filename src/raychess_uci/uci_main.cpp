@@ -0,0 +1,23 @@
+/**
+ * @file    uci_main.cpp
+ *
+ * @brief   Entry point of the UCI executable.
+ *
+ * @section DESCRIPTION
+ *
+ * Runs the engine under a chess GUI or tournament manager speaking the Universal Chess Interface
+ * on the standard input and output, without a window.
+ */
+
+#include <cstdlib>
+
+#include "uci_engine.hpp"
+
+using namespace raychess;
+
+int main(void)
+{
+    uci::Engine engine;
+    engine.Run();
+    return EXIT_SUCCESS;
+}